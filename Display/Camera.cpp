@@ -20,6 +20,7 @@ Camera::Camera()
     this->minZoom = 0.5f;
     this->maxZoom = 2.0f;
     isCameraChanged = true;
+    version = 1;
 }
 
 /*
@@ -35,6 +36,7 @@ void Camera::MoveCamera(int &mouseX, int &mouseY,
     mouseY = tempMouseY;
 
     isCameraChanged = true;
+    version++;
 }
 
 /*
@@ -58,6 +60,7 @@ bool Camera::SetZoom(float zoomVal)
     {
         zoom = zoomVal;
         isCameraChanged = true;
+        version++;
         isZoomChanged = true;
     }
 
@@ -79,6 +82,7 @@ bool Camera::SetMinZoom(float minZoom)
         if(zoom < minZoom)
         {
             zoom = minZoom;
+            version++;
         }
 
         isMinChanged = true;
@@ -102,6 +106,7 @@ bool Camera::SetMaxZoom(float maxZoom)
         if(zoom > maxZoom)
         {
             zoom = maxZoom;
+            version++;
         }
 
         isMaxChanged = true;
@@ -115,3 +120,5 @@ float Camera::GetZoom() const { return zoom; }
 float Camera::GetMinZoom() const { return minZoom; }
 
 float Camera::GetMaxZoom() const { return maxZoom; }
+
+unsigned int Camera::GetVersion() const { return version; }
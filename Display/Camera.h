@@ -74,10 +74,18 @@ class Camera
         float GetMinZoom() const;
         float GetMaxZoom() const;
 
+        /**
+         * @return Version of the camera transform, changed every time the
+         *         camera is moved or zoomed. Used to know when the screen
+         *         positions of the cubes are outdated.
+         */
+        unsigned int GetVersion() const;
+
     private:
         float zoom;
         float minZoom;
         float maxZoom;
+        unsigned int version;
 };
 
 #endif // CAMERA_H
@@ -0,0 +1,119 @@
+/*
+ * Project: Tower Defense
+ * File: RenderQueue.cpp
+ * Unit test file: TestRenderQueue.cpp
+ *
+ * Brief: This class contains the list of the objects drawn during a frame
+ *        with their sort keys. The keys are radix sorted (8 bits at a time,
+ *        skipping the bytes that are the same for every key) so that the
+ *        level is drawn back to front in one pass over the objects instead of
+ *        one pass over the cubes per diagonal.
+ */
+
+#include <algorithm>
+#include "RenderQueue.h"
+
+/* Bits of the sort key given to each field (from the most significant). */
+#define RENDER_KEY_LAYER_BITS 4
+#define RENDER_KEY_DIAGONAL_BITS 28
+#define RENDER_KEY_DEPTH_BITS 16
+#define RENDER_KEY_TEXTURE_BITS 16
+
+/**
+ * @brief Clamps a value to the range of a field of the sort key.
+ */
+static uint64_t ToKeyField(int value, int nbBits);
+
+RenderQueue::RenderQueue()
+{
+
+}
+
+/*
+ * Clamps a value to the range of a field of the sort key.
+ */
+static uint64_t ToKeyField(int value, int nbBits)
+{
+    int64_t max = (int64_t(1) << nbBits) - 1;
+
+    return std::min(std::max(int64_t(value), int64_t(0)), max);
+}
+
+/*
+ * Removes every object.
+ */
+void RenderQueue::Clear()
+{
+    items.clear();
+}
+
+/*
+ * Adds an object to draw.
+ */
+void RenderQueue::Push(int layer, int diagonal, int depth, int texture,
+                       int type, int index)
+{
+    uint64_t key = ToKeyField(layer, RENDER_KEY_LAYER_BITS);
+
+    key = key << RENDER_KEY_DIAGONAL_BITS
+          | ToKeyField(diagonal, RENDER_KEY_DIAGONAL_BITS);
+    key = key << RENDER_KEY_DEPTH_BITS
+          | ToKeyField(depth, RENDER_KEY_DEPTH_BITS);
+    key = key << RENDER_KEY_TEXTURE_BITS
+          | ToKeyField(texture, RENDER_KEY_TEXTURE_BITS);
+
+    items.push_back({key, type, index});
+}
+
+/*
+ * Sorts the objects in drawing order (LSD radix sort, stable).
+ */
+void RenderQueue::Sort()
+{
+    static const int nbBytes = sizeof(uint64_t);
+    unsigned int counts[nbBytes][256] = {};
+
+    if(items.size() < 2)
+    {
+        return;
+    }
+
+    /* Count the values of every byte of the keys in a single pass. */
+    for(auto const &i : items)
+    {
+        for(int byte = 0; byte < nbBytes; byte++)
+        {
+            counts[byte][(i.key >> (byte * 8)) & 0xFF]++;
+        }
+    }
+
+    sortedItems.resize(items.size());
+
+    for(int byte = 0; byte < nbBytes; byte++)
+    {
+        unsigned int *byteCounts = counts[byte];
+        unsigned int offset = 0;
+
+        /* Every key has the same value for this byte, nothing to sort. */
+        if(byteCounts[(items[0].key >> (byte * 8)) & 0xFF] == items.size())
+        {
+            continue;
+        }
+
+        for(int value = 0; value < 256; value++)
+        {
+            unsigned int count = byteCounts[value];
+            byteCounts[value] = offset;
+            offset += count;
+        }
+
+        for(auto const &i : items)
+        {
+            sortedItems[byteCounts[(i.key >> (byte * 8)) & 0xFF]++] = i;
+        }
+
+        items.swap(sortedItems);
+    }
+}
+
+const std::vector<RenderItem> &RenderQueue::GetItems() const { return items; }
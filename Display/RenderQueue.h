@@ -0,0 +1,83 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Constants for the layers of a frame, drawn one after the other.
+ */
+enum RENDERLAYER {RENDER_LAYER_LEVEL, RENDER_LAYER_HIGHLIGHT};
+
+/**
+ * @brief Constants for the kinds of objects drawn with a render queue.
+ */
+enum RENDERITEM {RENDER_ITEM_CUBE, RENDER_ITEM_TOWER, RENDER_ITEM_UNIT,
+                 RENDER_ITEM_HIGHLIGHT};
+
+/**
+ * @brief Object to draw, with its sort key.
+ *
+ * @param key:   Sort key (layer, diagonal, depth, texture from the most to the
+ *               least significant bits).
+ * @param type:  Kind of object (RENDER_ITEM_ constant).
+ * @param index: Position of the object in its vector (cubes, towers, units).
+ */
+typedef struct RenderItem{
+    uint64_t key;
+    int type;
+    int index;
+} RenderItem;
+
+/**
+ * @brief List of the objects to draw during a frame. The objects are pushed
+ *        in any order with their layer, diagonal (row + column of their cube),
+ *        depth inside of their cube and texture, radix sorted once, then
+ *        drawn in a single pass: farther diagonals first, and for the same
+ *        depth the objects sharing a texture are drawn together.
+ */
+class RenderQueue
+{
+    public:
+        RenderQueue();
+
+        /**
+         * @brief Removes every object (the memory is kept for the next
+         *        frame).
+         */
+        void Clear();
+
+        /**
+         * @brief Adds an object to draw.
+         *
+         * @param layer:    Layer of the object (RENDER_LAYER_ constant).
+         * @param diagonal: Row + column of the cube of the object, relative
+         *                  to the lowest one of the grid (0 or more).
+         * @param depth:    Depth of the object inside of its cube (0 for the
+         *                  cube itself, higher is drawn later).
+         * @param texture:  Texture of the object (objects with the same
+         *                  texture are drawn one after the other).
+         * @param type:     Kind of object (RENDER_ITEM_ constant).
+         * @param index:    Position of the object in its vector.
+         */
+        void Push(int layer, int diagonal, int depth, int texture, int type,
+                  int index);
+
+        /**
+         * @brief Sorts the objects in drawing order, in linear time.
+         */
+        void Sort();
+
+        /**
+         * @return Objects to draw (in drawing order after Sort).
+         */
+        const std::vector<RenderItem> &GetItems() const;
+
+    private:
+        std::vector<RenderItem> items;
+
+        /* Second buffer of the radix sort. */
+        std::vector<RenderItem> sortedItems;
+};
+
+#endif // RENDERQUEUE_H
@@ -9,9 +9,56 @@
  *        scene objects or level objects, as well as HUD components.
  */
 
+#include <algorithm>
 #include "../~External Libraries/SDL2_gfxPrimitives.h"
 #include "Renderer.h"
 
+/*
+ * Bits of the render queue keys holding the texture (see GetTextureKey): the
+ * type of the texture in the 4 high bits and the id of the object in the
+ * RENDER_TEXTURE_ID_BITS low bits. Ids up to RENDER_TEXTURE_MAX_ID fit,
+ * higher ids are clamped to it.
+ */
+#define RENDER_TEXTURE_KEY_MASK 0xFFFF
+#define RENDER_TEXTURE_ID_BITS 12
+#define RENDER_TEXTURE_ID_MASK ((1 << RENDER_TEXTURE_ID_BITS) - 1)
+#define RENDER_TEXTURE_MAX_ID RENDER_TEXTURE_ID_MASK
+
+/**
+ * @brief Returns the key of a texture in the render queue.
+ *
+ * @param textureType: Type of the texture (TEXTURETYPE constant).
+ * @param objectId:    Id of the object using the texture (0 to
+ *                     RENDER_TEXTURE_MAX_ID, clamped otherwise).
+ */
+static int GetTextureKey(int textureType, int objectId);
+
+/**
+ * @brief Returns true if a destination rectangle overlaps the screen.
+ *
+ * @param dst:          Destination rectangle.
+ * @param screenWidth:  Width of the screen.
+ * @param screenHeight: Height of the screen.
+ */
+static bool IsOnScreen(const SDL_Rect &dst, int screenWidth,
+                       int screenHeight);
+
+/**
+ * @brief Adds the screen area of an entity to a list of areas that do not
+ *        overlap, merging it with the areas it overlaps (along with their
+ *        lists of entities).
+ *
+ * @param areas:    Areas that do not overlap each other.
+ * @param entities: Entities of the areas.
+ * @param type:     Kind of entity (RENDER_ITEM_TOWER or RENDER_ITEM_UNIT).
+ * @param index:    Position of the entity in the towers or units vector.
+ * @param diagonal: Diagonal (x + y) of the cube of the entity.
+ * @param rect:     Screen area of the entity.
+ */
+static void AddArea(std::vector<EntityArea> &areas,
+                    std::vector<AreaEntity> &entities, int type, int index,
+                    int diagonal, const SDL_Rect &rect);
+
 /**
  * @brief Draws a border around a destination rectangle.
  *
@@ -27,27 +74,95 @@ static void DrawBorder(SDL_Renderer *renderer, int borderSize, SDL_Color color,
  * @brief Renders a text on screen along with its shadow if it has one.
  *
  * @param renderer:      Rendering target.
+ * @param spriteBatch:   Batch used to draw the text.
  * @param parentCompDst: Rendering destination of the text component's parent.
  * @param text:          Reference to the text to render.
  */
-static void RenderText(SDL_Renderer *renderer, SDL_Rect parentCompDst,
-                       std::shared_ptr<Text> &text);
+static void RenderText(SDL_Renderer *renderer, SpriteBatch &spriteBatch,
+                       SDL_Rect parentCompDst, std::shared_ptr<Text> &text);
 
 /**
  * @brief Renders an image on screen.
  *
- * @param renderer: Rendering target.
- * @param textures: Textures object containing sprites and textures.
- * @param src:      Source coordinates of the image to render.
- * @param dst:      Destination coordinates of the image to render.
- * @param fileNo:   Image file number in which to find the image to render.
+ * @param renderer:    Rendering target.
+ * @param spriteBatch: Batch used to draw the image.
+ * @param textures:    Textures object containing sprites and textures.
+ * @param src:         Source coordinates of the image to render.
+ * @param dst:         Destination coordinates of the image to render.
+ * @param fileNo:      Image file number in which to find the image to render.
  */
-static void RenderImage(SDL_Renderer *renderer, Textures &textures,
-                        SDL_Rect src, SDL_Rect dst, int imgId);
+static void RenderImage(SDL_Renderer *renderer, SpriteBatch &spriteBatch,
+                        Textures &textures, SDL_Rect src, SDL_Rect dst,
+                        int imgId);
 
 Renderer::Renderer()
 {
     renderDelay = 10;
+    cameraVersion = 0;
+    srcTerrainVersion = 0;
+    dstTerrainVersion = 0;
+}
+
+/*
+ * Returns the key of a texture in the render queue.
+ */
+static int GetTextureKey(int textureType, int objectId)
+{
+    objectId = std::min(std::max(objectId, 0), RENDER_TEXTURE_MAX_ID);
+
+    return (textureType << RENDER_TEXTURE_ID_BITS | objectId)
+           & RENDER_TEXTURE_KEY_MASK;
+}
+
+/*
+ * Returns true if a destination rectangle overlaps the screen.
+ */
+static bool IsOnScreen(const SDL_Rect &dst, int screenWidth,
+                       int screenHeight)
+{
+    return dst.x + dst.w > 0 && dst.x < screenWidth && dst.y + dst.h > 0
+           && dst.y < screenHeight;
+}
+
+/*
+ * Adds the screen area of an entity to a list of areas that do not overlap.
+ */
+static void AddArea(std::vector<EntityArea> &areas,
+                    std::vector<AreaEntity> &entities, int type, int index,
+                    int diagonal, const SDL_Rect &rect)
+{
+    int entity = entities.size();
+    EntityArea area = {rect, diagonal, entity, entity};
+    bool isMerged = true;
+
+    entities.push_back({type, index, -1});
+
+    /* The merged area can overlap areas that were already checked. */
+    while(isMerged)
+    {
+        isMerged = false;
+
+        for(unsigned int i = 0; i < areas.size();)
+        {
+            if(!SDL_HasIntersection(&areas[i].rect, &area.rect))
+            {
+                i++;
+                continue;
+            }
+
+            /* Take the entities of the overlapped area. */
+            SDL_UnionRect(&areas[i].rect, &area.rect, &area.rect);
+            area.minDiagonal = std::min(area.minDiagonal,
+                                        areas[i].minDiagonal);
+            entities[areas[i].last].next = area.first;
+            area.first = areas[i].first;
+            areas[i] = areas.back();
+            areas.pop_back();
+            isMerged = true;
+        }
+    }
+
+    areas.push_back(area);
 }
 
 /*
@@ -78,6 +193,8 @@ void Renderer::RenderSceneHud(Display &display, Scene &scene,
     }
 
     /* Render the black screen (transition screen). */
+    spriteBatch.Flush(display.renderer);
+
     if(!scene.isTransitionDone)
     {
         SDL_Rect dest = {0, 0, display.GetWinLength(), display.GetWinHeight()};
@@ -94,6 +211,9 @@ void Renderer::RenderHud(SDL_Renderer *renderer, std::shared_ptr<Hud> &hud,
 {
     if(hud != nullptr)
     {
+        /* The background and the border are drawn without the batch. */
+        spriteBatch.Flush(renderer);
+
         /* Draw HUD background. */
         if(hud->hasBackground)
         {
@@ -127,7 +247,7 @@ void Renderer::RenderHud(SDL_Renderer *renderer, std::shared_ptr<Hud> &hud,
                 imagePos.w = i.dst.w;
                 imagePos.h = i.dst.h;
 
-                RenderImage(renderer, textures, i.src, imagePos,
+                RenderImage(renderer, spriteBatch, textures, i.src, imagePos,
                             i.GetFileNo());
             }
         }
@@ -167,6 +287,8 @@ void Renderer::RenderHud(SDL_Renderer *renderer, std::shared_ptr<Hud> &hud,
                 buttonPos.w = i.dst.w;
                 buttonPos.h = i.dst.h;
 
+                spriteBatch.Flush(renderer);
+
                 if(!i.isHovered)
                 {
                     SDL_SetRenderDrawColor(renderer,
@@ -194,7 +316,7 @@ void Renderer::RenderHud(SDL_Renderer *renderer, std::shared_ptr<Hud> &hud,
                 {
                     if(j != nullptr && j->isVisible)
                     {
-                        RenderText(renderer, buttonPos, j);
+                        RenderText(renderer, spriteBatch, buttonPos, j);
                     }
                 }
             }
@@ -205,7 +327,7 @@ void Renderer::RenderHud(SDL_Renderer *renderer, std::shared_ptr<Hud> &hud,
         {
             if(i->isVisible)
             {
-                RenderText(renderer, hud->dst, i);
+                RenderText(renderer, spriteBatch, hud->dst, i);
             }
         }
     }
@@ -217,22 +339,20 @@ void Renderer::RenderHud(SDL_Renderer *renderer, std::shared_ptr<Hud> &hud,
 /*
  * Renders an image on screen.
  */
-static void RenderImage(SDL_Renderer *renderer, Textures &textures,
-                        SDL_Rect src, SDL_Rect dst, int fileNo)
+static void RenderImage(SDL_Renderer *renderer, SpriteBatch &spriteBatch,
+                        Textures &textures, SDL_Rect src, SDL_Rect dst,
+                        int fileNo)
 {
     SDL_Texture *tempText = textures.GetTexture(renderer, TEXTURE_HUD, fileNo);
 
-    if(tempText != nullptr)
-    {
-        SDL_RenderCopy(renderer, tempText, &src, &dst);
-    }
+    spriteBatch.Draw(renderer, tempText, &src, &dst);
 }
 
 /*
  * Renders a text on screen along with its shadow if it has one.
  */
-static void RenderText(SDL_Renderer *renderer, SDL_Rect parentCompDst,
-                       std::shared_ptr<Text> &text)
+static void RenderText(SDL_Renderer *renderer, SpriteBatch &spriteBatch,
+                       SDL_Rect parentCompDst, std::shared_ptr<Text> &text)
 {
     if(text != nullptr)
     {
@@ -243,20 +363,17 @@ static void RenderText(SDL_Renderer *renderer, SDL_Rect parentCompDst,
         textPos.h = text->dst.h;
 
         /* Render the text's shadow. */
-        if(text->GetIsShadowEnabled() && text->GetShadowTexture() != nullptr)
+        if(text->GetIsShadowEnabled())
         {
-            SDL_RenderCopy(renderer, text->GetShadowTexture(),
-                           &text->src, &textPos);
+            spriteBatch.Draw(renderer, text->GetShadowTexture(), &text->src,
+                             &textPos);
         }
 
         textPos.x = parentCompDst.x + text->dst.x;
         textPos.y = parentCompDst.y + text->dst.y;
 
         /* Render the text itself. */
-        if(text->GetTexture() != nullptr)
-        {
-            SDL_RenderCopy(renderer, text->GetTexture(), &text->src, &textPos);
-        }
+        spriteBatch.Draw(renderer, text->GetTexture(), &text->src, &textPos);
     }
 }
 
@@ -307,39 +424,27 @@ static void DrawBorder(SDL_Renderer *renderer, int borderSize, SDL_Color color,
 }
 
 /*
- * Renders the entities associated with a cube.
+ * Adds an entity to the render queue, in front of its cube.
  */
-void Renderer::RenderEntities(SDL_Renderer *renderer, Level &level,
-                              Textures &textures, int cubeX, int cubeY)
+void Renderer::QueueEntity(Level &level, const Entities &entity,
+                           int textureType, int type, int index)
 {
-    /* Render units associated with the cube. */
-    for(auto &i : level.units)
+    const Cube *cube = level.grid.At(entity.cubeX, entity.cubeY);
+
+    /* Entities are only rendered on top of a cube. */
+    if(cube == nullptr)
     {
-        if(i.isVisible && i.cubeX == cubeX && i.cubeY == cubeY)
-        {
-            SDL_Texture *tempText = textures.GetTexture(renderer,
-                                                        TEXTURE_UNIT, i.id);
-            if(tempText != nullptr)
-            {
-                SDL_RenderCopy(renderer, tempText, &i.src, &i.dst);
-            }
-        }
+        return;
     }
 
-    /* Render turrets associated with the cube. */
-    for(auto &i : level.towers)
-    {
-        if(i.cubeX == cubeX && i.cubeY == cubeY)
-        {
-            SDL_Texture *tempText = textures.GetTexture(renderer,
-                                                        TEXTURE_TOWER, i.id);
+    /* Entities lower on the screen are in front of the others. */
+    int depth = entity.dst.y + entity.dst.h - cube->dst.y + 1;
 
-            if(tempText != nullptr)
-            {
-                SDL_RenderCopy(renderer, tempText, &i.src, &i.dst);
-            }
-        }
-    }
+    renderQueue.Push(RENDER_LAYER_LEVEL,
+                     cube->coordX + cube->coordY
+                     - level.grid.GetLowestRowPlusCol(),
+                     std::max(depth, 1), GetTextureKey(textureType, entity.id),
+                     type, index);
 }
 
 /*
@@ -355,18 +460,36 @@ void Renderer::SetSrcPositions(Level &level, Camera &camera,
     int unitSrcLength = textures.unitSrcLength;
     int unitSrcHeight = textures.unitSrcHeight;
 
+    /*
+     * Everything is updated for a new level or when cubes were added or moved
+     * (not when their wall state changed).
+     */
+    bool isLevelChanged = !level.isSrcUpdated
+                          || level.grid.GetTerrainVersion()
+                             != srcTerrainVersion;
+
     /* Set cube src coordinates. */
-    for(auto &i : level.grid.cubes)
+    if(isLevelChanged)
     {
-        i.src.w = cubeSrcLength;
-        i.src.h = cubeSrcHeight;
-        i.src.x = i.GetId() * cubeSrcLength;
-        i.src.y = i.GetId() / textures.imgNbCubesLength * cubeSrcHeight;
+        for(auto &i : level.grid.cubes)
+        {
+            i.src.w = cubeSrcLength;
+            i.src.h = cubeSrcHeight;
+            i.src.x = i.GetId() * cubeSrcLength;
+            i.src.y = i.GetId() / textures.imgNbCubesLength * cubeSrcHeight;
+        }
+
+        srcTerrainVersion = level.grid.GetTerrainVersion();
     }
 
-    /* Set tower src coordinates. */
+    /* Set tower src coordinates (when they turned or were upgraded). */
     for(auto &i : level.towers)
     {
+        if(!isLevelChanged && !i.isDirty)
+        {
+            continue;
+        }
+
         i.src.w = towerSrcLength;
         i.src.h = towerSrcHeight;
         i.src.x = towerSrcLength * i.orientation;
@@ -376,6 +499,11 @@ void Renderer::SetSrcPositions(Level &level, Camera &camera,
     /* Set unit src coordinates. */
     for(auto &i : level.units)
     {
+        if(!isLevelChanged && !i.isDirty)
+        {
+            continue;
+        }
+
         i.src.w = unitSrcLength;
         i.src.h = unitSrcHeight;
 
@@ -409,135 +537,325 @@ void Renderer::SetDstPositions(Level &level, Camera &camera,
     int unitDstWidth = textures.unitSrcLength * cameraZoom;
     int unitDstHeight = textures.unitSrcHeight * cameraZoom;
 
-    /* Set cubes dst coordinates. */
-    for(auto &i : level.grid.cubes)
+    /*
+     * The cubes only move on the screen when the camera is moved or zoomed,
+     * or when cubes are added or moved.
+     */
+    bool isTerrainChanged = camera.GetVersion() != cameraVersion
+                            || level.grid.GetTerrainVersion()
+                               != dstTerrainVersion;
+
+    if(isTerrainChanged)
     {
-        i.dst.w = cubeSrcLength * cameraZoom;
-        i.dst.h = cubeSrcHeight * cameraZoom;
-        i.dst.x = i.dst.w / 2 * (i.coordX - i.coordY) + camera.x;
-        i.dst.y = i.dst.h / 4 * (i.coordX + i.coordY) + camera.y + i.coordZ *
-                  cameraZoom;
+        /* Give the projection to the grid so that it can pick cubes. */
+        level.grid.SetProjection(camera.x, camera.y,
+                                 cubeSrcLength * cameraZoom,
+                                 cubeSrcHeight * cameraZoom, cameraZoom);
+
+        /* Set cubes dst coordinates. */
+        for(auto &i : level.grid.cubes)
+        {
+            i.dst.w = cubeSrcLength * cameraZoom;
+            i.dst.h = cubeSrcHeight * cameraZoom;
+            i.dst.x = i.dst.w / 2 * (i.coordX - i.coordY) + camera.x;
+            i.dst.y = i.dst.h / 4 * (i.coordX + i.coordY) + camera.y
+                      + i.coordZ * cameraZoom;
+        }
+
+        cameraVersion = camera.GetVersion();
+        dstTerrainVersion = level.grid.GetTerrainVersion();
     }
 
-    /* Set towers dst coordinates. */
+    /* Set towers dst coordinates (when the camera or the tower changed). */
     for(auto &i : level.towers)
     {
+        if(!isTerrainChanged && !i.isDirty)
+        {
+            continue;
+        }
+
+        i.dst.w = towerDstWidth;
+        i.dst.h = towerDstHeight;
+
         int cubeMidPosX = cubeMidX * (i.cubeX - i.cubeY);
         int cubeMidPosY = cubeMidY * (i.cubeX + i.cubeY);
         int towerCenterX = camera.x - i.dst.w / 2 + cubeMidX;
         int towerCenterY = camera.y - i.dst.h + cubeSrcHeight * cameraZoom / 2;
 
-        i.dst.w = towerDstWidth;
-        i.dst.h = towerDstHeight;
         i.dst.x = cubeMidPosX + towerCenterX;
         i.dst.y = cubeMidPosY + towerCenterY;
+        i.isDirty = false;
     }
 
-    /* Set units dst coordinates. */
+    /* Set units dst coordinates (when the camera changed or they moved). */
     for(auto &i : level.units)
     {
+        if(!isTerrainChanged && !i.isDirty)
+        {
+            continue;
+        }
+
+        i.dst.w = unitDstWidth;
+        i.dst.h = unitDstHeight;
+
         int cubeCenterX = cubeMidX * (i.cubeX - i.cubeY);
         int cubeCenterY = cubeMidY + cubeMidY * (i.cubeY + i.cubeX);
         int unitPositionX = cubeMidX + i.x * cameraZoom + camera.x -
                             i.dst.w / 2;
         int unitPositionY = -i.dst.h + i.y * cameraZoom + camera.y;
 
-        i.dst.w = unitDstWidth;
-        i.dst.h = unitDstHeight;
         i.dst.x = cubeCenterX + unitPositionX;
         i.dst.y = cubeCenterY + unitPositionY;
+        i.isDirty = false;
     }
 }
 
 /*
- * Renders game elements such as the cubes, enemies and towers.
+ * Draws the objects of the render queue in a single pass.
  */
-void Renderer::RenderLevel(SDL_Renderer *renderer, Camera &camera,
-                          Level &level, Textures &textures)
+void Renderer::RenderQueueItems(SDL_Renderer *renderer, Level &level,
+                                Textures &textures)
 {
-    int lowestRowPlusCol = level.grid.GetLowestRowPlusCol();
-    int currentRowPlusCol = 0;
-    bool isAllCubesRendered = false;
+    int lastTexture = -1;
+    SDL_Texture *tempText = nullptr;
 
-    /* Updates all the cube and entity src position when necessary. */
-    if(!level.isSrcUpdated)
+    for(auto const &i : renderQueue.GetItems())
     {
-        SetSrcPositions(level, camera, textures);
+        const SDL_Rect *src = nullptr;
+        const SDL_Rect *dst = nullptr;
+        SDL_Rect highlightSrc = {0, 601, 205, 119};
+        SDL_Rect highlightDst;
+        int texture = i.key & RENDER_TEXTURE_KEY_MASK;
+
+        switch(i.type)
+        {
+        case RENDER_ITEM_CUBE:
+            src = &level.grid.cubes[i.index].src;
+            dst = &level.grid.cubes[i.index].dst;
+            break;
+        case RENDER_ITEM_TOWER:
+            src = &level.towers[i.index].src;
+            dst = &level.towers[i.index].dst;
+            break;
+        case RENDER_ITEM_UNIT:
+            src = &level.units[i.index].src;
+            dst = &level.units[i.index].dst;
+            break;
+        case RENDER_ITEM_HIGHLIGHT:
+            highlightDst = level.grid.cubes[i.index].dst;
+            highlightDst.h /= 2;
+            src = &highlightSrc;
+            dst = &highlightDst;
+            break;
+        }
+
+        /* Objects sharing a texture follow each other in the queue. */
+        if(texture != lastTexture)
+        {
+            tempText = textures.GetTexture(renderer,
+                                           texture >> RENDER_TEXTURE_ID_BITS,
+                                           texture & RENDER_TEXTURE_ID_MASK);
+            lastTexture = texture;
+        }
+
+        spriteBatch.Draw(renderer, tempText, src, dst);
     }
+}
 
-    /* Update all cube and entity dst positions. */
-    SetDstPositions(level, camera, textures);
+/*
+ * Draws the entities over the cached terrain, with the cubes in front of
+ * them.
+ */
+void Renderer::RenderEntityAreas(SDL_Renderer *renderer, Level &level,
+                                 Textures &textures, int screenWidth,
+                                 int screenHeight)
+{
+    SDL_Rect screen = {0, 0, screenWidth, screenHeight};
+    SDL_Rect area;
+
+    /*
+     * Merge the screen areas of the entities until they do not overlap, so
+     * that every entity is drawn once. Every area keeps the list of its
+     * entities.
+     */
+    entityAreas.clear();
+    areaEntities.clear();
+
+    for(unsigned int i = 0; i < level.towers.size(); i++)
+    {
+        const Tower &tower = level.towers[i];
 
-    /* Render all the cubes along with their associated entities. */
-    while(!isAllCubesRendered)
+        if(SDL_IntersectRect(&tower.dst, &screen, &area))
+        {
+            AddArea(entityAreas, areaEntities, RENDER_ITEM_TOWER, i,
+                    tower.cubeX + tower.cubeY, area);
+        }
+    }
+
+    for(unsigned int i = 0; i < level.units.size(); i++)
     {
-        for(auto &i : level.grid.cubes)
+        const Unit &unit = level.units[i];
+
+        if(unit.isVisible && SDL_IntersectRect(&unit.dst, &screen, &area))
+        {
+            AddArea(entityAreas, areaEntities, RENDER_ITEM_UNIT, i,
+                    unit.cubeX + unit.cubeY, area);
+        }
+    }
+
+    for(auto const &i : entityAreas)
+    {
+        renderQueue.Clear();
+
+        for(int j = i.first; j >= 0; j = areaEntities[j].next)
         {
-            if(!i.isRendered)
+            const AreaEntity &entity = areaEntities[j];
+
+            if(entity.type == RENDER_ITEM_TOWER)
             {
-                if(i.coordX + i.coordY == lowestRowPlusCol + currentRowPlusCol)
-                {
-                    SDL_Texture *tempText = textures.GetTexture(renderer,
-                                                                TEXTURE_CUBE,
-                                                                0);
-                    /* Render the cube. */
-                    if(tempText != nullptr)
-                    {
-                        SDL_RenderCopy(renderer, tempText, &i.src, &i.dst);
-                    }
+                QueueEntity(level, level.towers[entity.index], TEXTURE_TOWER,
+                            RENDER_ITEM_TOWER, entity.index);
+            }
+            else
+            {
+                QueueEntity(level, level.units[entity.index], TEXTURE_UNIT,
+                            RENDER_ITEM_UNIT, entity.index);
+            }
+        }
 
-                    /* Render the entities associated with the cube. */
-                    RenderEntities(renderer, level, textures,
-                                   i.coordX, i.coordY);
+        /*
+         * The cubes behind every entity of the area are already right in the
+         * tiles, the others are drawn again around the entities.
+         */
+        level.grid.GetCubesInScreenRect(i.rect.x, i.rect.y, i.rect.w,
+                                        i.rect.h, cubeIndexes);
 
-                    i.isRendered = true;
-                }
+        for(auto const &j : cubeIndexes)
+        {
+            const Cube &cube = level.grid.cubes[j];
+
+            if(cube.coordX + cube.coordY >= i.minDiagonal)
+            {
+                renderQueue.Push(RENDER_LAYER_LEVEL, cube.coordX + cube.coordY
+                                 - level.grid.GetLowestRowPlusCol(), 0,
+                                 GetTextureKey(TEXTURE_CUBE, 0),
+                                 RENDER_ITEM_CUBE, j);
             }
         }
 
-        /* Assume that all cubes have been rendered. */
-        isAllCubesRendered = true;
+        /* The clip rectangle is used when the batch is drawn. */
+        renderQueue.Sort();
+        spriteBatch.Flush(renderer);
+        SDL_RenderSetClipRect(renderer, &i.rect);
+        RenderQueueItems(renderer, level, textures);
+        spriteBatch.Flush(renderer);
+    }
+
+    SDL_RenderSetClipRect(renderer, nullptr);
+}
+
+/*
+ * Renders game elements such as the cubes, enemies and towers.
+ */
+void Renderer::RenderLevel(SDL_Renderer *renderer, Camera &camera,
+                          Level &level, Textures &textures)
+{
+    int lowestRowPlusCol = level.grid.GetLowestRowPlusCol();
+    int screenWidth = 0;
+    int screenHeight = 0;
+
+    SDL_GetRendererOutputSize(renderer, &screenWidth, &screenHeight);
 
-        /* Check if all cubes really have been rendered. */
-        for(auto const &i : level.grid.cubes)
+    /*
+     * Update the cube and entity src and dst positions that changed (the
+     * entities are marked dirty until both are updated).
+     */
+    SetSrcPositions(level, camera, textures);
+    SetDstPositions(level, camera, textures);
+
+    /*
+     * Draw the cubes with the cached tiles, then the entities over them. When
+     * the cache cannot be used, the cubes are drawn one by one with the
+     * entities below.
+     */
+    bool isTerrainCached = terrainCache.Render(renderer, camera, level,
+                                               textures, spriteBatch,
+                                               screenWidth, screenHeight);
+
+    if(isTerrainCached)
+    {
+        RenderEntityAreas(renderer, level, textures, screenWidth,
+                          screenHeight);
+    }
+
+    /*
+     * Queue the cubes (when not cached), the highlights and the entities on
+     * the screen with their diagonal (farther ones are drawn first), then
+     * sort them once. The cubes of the chunks outside of the screen are never
+     * visited.
+     */
+    renderQueue.Clear();
+    level.grid.GetVisibleChunks(screenWidth, screenHeight, visibleChunks);
+
+    for(auto const &chunkIndex : visibleChunks)
+    {
+        const GridChunk &chunk = level.grid.GetChunks().GetChunks()[chunkIndex];
+
+        for(auto const &i : chunk.cubeIndexes)
         {
-            if(!i.isRendered)
+            const Cube &cube = level.grid.cubes[i];
+            int diagonal = cube.coordX + cube.coordY - lowestRowPlusCol;
+
+            if(!IsOnScreen(cube.dst, screenWidth, screenHeight))
             {
-                isAllCubesRendered = false;
-                break;
+                continue;
+            }
+
+            if(!isTerrainCached)
+            {
+                renderQueue.Push(RENDER_LAYER_LEVEL, diagonal, 0,
+                                 GetTextureKey(TEXTURE_CUBE, 0),
+                                 RENDER_ITEM_CUBE, i);
+            }
+
+            if(cube.isHighlighted)
+            {
+                renderQueue.Push(RENDER_LAYER_HIGHLIGHT, diagonal, 0,
+                                 GetTextureKey(TEXTURE_HUD, 0),
+                                 RENDER_ITEM_HIGHLIGHT, i);
             }
         }
+    }
 
-        currentRowPlusCol++;
+    for(unsigned int i = 0; i < level.towers.size() && !isTerrainCached; i++)
+    {
+        if(IsOnScreen(level.towers[i].dst, screenWidth, screenHeight))
+        {
+            QueueEntity(level, level.towers[i], TEXTURE_TOWER,
+                        RENDER_ITEM_TOWER, i);
+        }
     }
 
-    /* Render cube highlights. */
-    for(auto &i : level.grid.cubes)
+    for(unsigned int i = 0; i < level.units.size() && !isTerrainCached; i++)
     {
-        /* Render the cube's highlight. */
-        if(i.isHighlighted)
+        if(level.units[i].isVisible
+           && IsOnScreen(level.units[i].dst, screenWidth, screenHeight))
         {
-            SDL_Rect src = {0, 601, 205, 119};
-            SDL_Rect dst = {i.dst.x, i.dst.y, i.dst.w, i.dst.h/2};
-            SDL_RenderCopy(renderer,
-                           textures.GetTexture(renderer, TEXTURE_HUD, 0),
-                           &src, &dst);
+            QueueEntity(level, level.units[i], TEXTURE_UNIT, RENDER_ITEM_UNIT,
+                        i);
         }
     }
+
+    renderQueue.Sort();
+    RenderQueueItems(renderer, level, textures);
+    spriteBatch.Flush(renderer);
+
     /* Render tower range indicators. */
     for(auto &i : level.towers)
     {
         if(i.isIndicatorActive)
         {
-            Cube *cube = nullptr;
-
-            for(auto &j : level.grid.cubes)
-            {
-                if(i.cubeX == j.coordX && i.cubeY == j.coordY)
-                {
-                    cube = &j;
-                }
-            }
+            Cube *cube = level.grid.At(i.cubeX, i.cubeY);
 
             if(cube != nullptr)
             {
@@ -547,12 +865,15 @@ void Renderer::RenderLevel(SDL_Renderer *renderer, Camera &camera,
             }
         }
     }
+}
 
-    /* Reset the isRendered tag. */
-    for(auto &i : level.grid.cubes)
-    {
-        i.isRendered = false;
-    }
+/*
+ * Draws what is left in the sprite batch and counts the batches of the frame.
+ */
+void Renderer::EndFrame(SDL_Renderer *renderer)
+{
+    spriteBatch.Flush(renderer);
+    spriteBatch.EndFrame();
 }
 
 /* [Deprecated] (Must be reworked)
@@ -594,3 +915,5 @@ static void RenderPortraitWidget(SDL_Renderer *renderer,
 
 }
 */
+
+const SpriteBatch &Renderer::GetSpriteBatch() const { return spriteBatch; }
@@ -3,8 +3,41 @@
 
 #include "Display.h"
 #include "Camera.h"
+#include "RenderQueue.h"
+#include "SpriteBatch.h"
+#include "TerrainCache.h"
 #include "../Controllers/Scene.h"
 
+/**
+ * @brief Screen area of entities drawn over the cached terrain (see
+ *        Renderer::RenderEntityAreas).
+ *
+ * @param rect:        Area on the screen.
+ * @param minDiagonal: Lowest diagonal (x + y) of the cubes of its entities.
+ * @param first:       Position of its first entity in the area entities.
+ * @param last:        Position of its last entity in the area entities.
+ */
+typedef struct EntityArea{
+    SDL_Rect rect;
+    int minDiagonal;
+    int first;
+    int last;
+} EntityArea;
+
+/**
+ * @brief Entity of an EntityArea.
+ *
+ * @param type:  Kind of entity (RENDER_ITEM_TOWER or RENDER_ITEM_UNIT).
+ * @param index: Position of the entity in the towers or units vector.
+ * @param next:  Position of the next entity of the same area in the area
+ *               entities, -1 for the last one.
+ */
+typedef struct AreaEntity{
+    int type;
+    int index;
+    int next;
+} AreaEntity;
+
 /**
  * @brief This class is used for rendering all the scene objects or level
  *        objects, as well as HUD components.
@@ -42,20 +75,94 @@ class Renderer
                          Textures &textures);
 
         /**
-         * @brief Renders the entities associated with a cube.
+         * @brief Draws what is left in the sprite batch and counts the
+         *        sprites, batches and flushes of the frame. Must be called
+         *        before presenting the frame.
          *
-         * @param display:  Display object containing the window and renderer.
+         * @param renderer: Rendering target.
+         */
+        void EndFrame(SDL_Renderer *renderer);
+
+        /**
+         * @return Sprite batch of the renderer, with the counters of the
+         *         last frame.
+         */
+        const SpriteBatch &GetSpriteBatch() const;
+
+    private:
+        /* Cubes and entities to draw during the frame, in drawing order. */
+        RenderQueue renderQueue;
+
+        /*
+         * Versions of the camera and terrain versions of the grid when the
+         * src and dst of the cubes were last updated (placing or selling a
+         * tower does not change the cubes, see Grid::GetTerrainVersion).
+         */
+        unsigned int cameraVersion;
+        unsigned int srcTerrainVersion;
+        unsigned int dstTerrainVersion;
+
+        /* Chunks of the grid on the screen during the frame. */
+        std::vector<int> visibleChunks;
+
+        /* Sprites drawn since the last flush, grouped by texture. */
+        SpriteBatch spriteBatch;
+
+        /* Cubes of the level pre-rendered into tiles. */
+        TerrainCache terrainCache;
+
+        /*
+         * Screen areas of the entities drawn over the cached terrain, their
+         * entities, and cubes drawn again in one of them.
+         */
+        std::vector<EntityArea> entityAreas;
+        std::vector<AreaEntity> areaEntities;
+        std::vector<int> cubeIndexes;
+
+        /**
+         * @brief Draws the objects of the render queue (sorted) in a single
+         *        pass.
+         *
+         * @param renderer: Rendering target.
          * @param level:    Level object containing entity and cube data.
          * @param textures: Textures object containing sprites and textures.
-         * @param cubeX:    Coordinates of the parent cube in x.
-         * @param cubeY:    Coordinates of the parent cube in y.
          */
-        void RenderEntities(SDL_Renderer *renderer, Level &level,
-                              Textures &textures, int cubeX, int cubeY);
+        void RenderQueueItems(SDL_Renderer *renderer, Level &level,
+                              Textures &textures);
+
+        /**
+         * @brief Draws the entities over the cached terrain. The cubes in
+         *        front of the entities are drawn again, clipped to the
+         *        screen areas of the entities, so that the entities stay
+         *        behind them.
+         *
+         * @param renderer:     Rendering target.
+         * @param level:        Level object containing entity and cube data.
+         * @param textures:     Textures object containing sprites and
+         *                      textures.
+         * @param screenWidth:  Width of the screen.
+         * @param screenHeight: Height of the screen.
+         */
+        void RenderEntityAreas(SDL_Renderer *renderer, Level &level,
+                               Textures &textures, int screenWidth,
+                               int screenHeight);
+
+        /**
+         * @brief Adds an entity to the render queue, in front of its cube
+         *        (entities lower on the screen are drawn last).
+         *
+         * @param level:       Level object containing entity and cube data.
+         * @param entity:      Tower or unit to render.
+         * @param textureType: Type of the texture of the entity.
+         * @param type:        Kind of entity (RENDER_ITEM_ constant).
+         * @param index:       Position of the entity in its vector.
+         */
+        void QueueEntity(Level &level, const Entities &entity,
+                         int textureType, int type, int index);
 
-    private:
         /**
-         * @brief Updates the source coordinates for cubes and entities.
+         * @brief Updates the source coordinates for cubes (for a new level
+         *        or when the grid changed) and dirty entities.
          *
          * @param level:    Level data object containing the cubes and entities
          *                  to update.
@@ -67,7 +174,9 @@ class Renderer
         void SetSrcPositions(Level &level, Camera &camera, Textures &textures);
 
         /**
-         * @brief Updates the destination coordinates for cubes and entities.
+         * @brief Updates the destination coordinates for cubes (when the
+         *        camera or the grid changed) and dirty entities, then clears
+         *        the dirty flags of the entities.
          *
          * @param level:    Level data object containing the cubes and entities
          *                  to update.
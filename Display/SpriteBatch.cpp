@@ -0,0 +1,146 @@
+/*
+ * Project: Tower Defense
+ * File: SpriteBatch.cpp
+ *
+ * Brief: This class draws the sprites sharing a texture with a single
+ *        SDL_RenderGeometry call (two triangles per sprite) instead of one
+ *        SDL_RenderCopy call per sprite, and counts the sprites, batches and
+ *        flushes of every frame.
+ */
+
+#include "SpriteBatch.h"
+
+SpriteBatch::SpriteBatch()
+{
+    batchTexture = nullptr;
+    textureWidth = 0;
+    textureHeight = 0;
+    nbSprites = 0;
+    nbBatches = 0;
+    nbFlushes = 0;
+    lastNbSprites = 0;
+    lastNbBatches = 0;
+    lastNbFlushes = 0;
+}
+
+/*
+ * Adds a sprite to the batch.
+ */
+void SpriteBatch::Draw(SDL_Renderer *renderer, SDL_Texture *texture,
+                       const SDL_Rect *src, const SDL_Rect *dst)
+{
+    if(texture == nullptr)
+    {
+        return;
+    }
+
+    nbSprites++;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if(texture != batchTexture
+       || vertices.size() >= SPRITE_BATCH_MAX_SPRITES * 4)
+    {
+        DrawBatch(renderer);
+        batchTexture = texture;
+        SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth,
+                         &textureHeight);
+    }
+
+    SDL_Rect source = {0, 0, textureWidth, textureHeight};
+
+    if(src != nullptr)
+    {
+        source = *src;
+    }
+
+    /* Corners of the sprite: top left, top right, bottom right, bottom left. */
+    float left = dst->x;
+    float top = dst->y;
+    float right = dst->x + dst->w;
+    float bottom = dst->y + dst->h;
+    float u1 = float(source.x) / textureWidth;
+    float v1 = float(source.y) / textureHeight;
+    float u2 = float(source.x + source.w) / textureWidth;
+    float v2 = float(source.y + source.h) / textureHeight;
+    SDL_Color color = {255, 255, 255, 255};
+    int first = vertices.size();
+
+    vertices.push_back({{left, top}, color, {u1, v1}});
+    vertices.push_back({{right, top}, color, {u2, v1}});
+    vertices.push_back({{right, bottom}, color, {u2, v2}});
+    vertices.push_back({{left, bottom}, color, {u1, v2}});
+
+    /* Two triangles per sprite. */
+    indices.push_back(first);
+    indices.push_back(first + 1);
+    indices.push_back(first + 2);
+    indices.push_back(first);
+    indices.push_back(first + 2);
+    indices.push_back(first + 3);
+#else
+    SDL_RenderCopy(renderer, texture, src, dst);
+    nbBatches++;
+#endif
+}
+
+/*
+ * Draws the sprites of the batch.
+ */
+void SpriteBatch::Flush(SDL_Renderer *renderer)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if(!vertices.empty())
+    {
+        nbFlushes++;
+        DrawBatch(renderer);
+    }
+#else
+    (void)renderer;
+#endif
+}
+
+/*
+ * Keeps the counters of the frame that ended.
+ */
+void SpriteBatch::EndFrame()
+{
+    lastNbSprites = nbSprites;
+    lastNbBatches = nbBatches;
+    lastNbFlushes = nbFlushes;
+    nbSprites = 0;
+    nbBatches = 0;
+    nbFlushes = 0;
+}
+
+/*
+ * Draws the sprites of the batch and empties it.
+ */
+void SpriteBatch::DrawBatch(SDL_Renderer *renderer)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if(vertices.empty())
+    {
+        return;
+    }
+
+    SDL_RenderGeometry(renderer, batchTexture, vertices.data(),
+                       vertices.size(), indices.data(), indices.size());
+    nbBatches++;
+    vertices.clear();
+    indices.clear();
+
+    /*
+     * The texture can be destroyed once drawn and another one created at the
+     * same address, so its size is queried again for the next sprite.
+     */
+    batchTexture = nullptr;
+#else
+    (void)renderer;
+#endif
+}
+
+int SpriteBatch::GetNbSprites() const { return lastNbSprites; }
+
+int SpriteBatch::GetNbBatches() const { return lastNbBatches; }
+
+int SpriteBatch::GetNbFlushes() const { return lastNbFlushes; }
@@ -0,0 +1,101 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <vector>
+#include <SDL.h>
+
+/* Most sprites in a batch (a full batch is drawn right away). */
+#define SPRITE_BATCH_MAX_SPRITES 4096
+
+/**
+ * @brief Accumulates the sprites drawn one after the other with the same
+ *        texture and draws them with a single SDL_RenderGeometry call. A
+ *        batch is drawn when the texture changes, when it is full or when it
+ *        is flushed (before anything drawn without the batch, or before
+ *        changing the render target or the clip rectangle). The color and
+ *        alpha modulation of the textures are not used. With SDL older than
+ *        2.0.18 every sprite is drawn right away with SDL_RenderCopy.
+ */
+class SpriteBatch
+{
+    public:
+        SpriteBatch();
+
+        /**
+         * @brief Adds a sprite to the batch.
+         *
+         * @param renderer: Rendering target.
+         * @param texture:  Texture of the sprite (nothing is drawn if
+         *                  nullptr).
+         * @param src:      Source rectangle in the texture (nullptr for the
+         *                  whole texture).
+         * @param dst:      Destination rectangle on the rendering target.
+         */
+        void Draw(SDL_Renderer *renderer, SDL_Texture *texture,
+                  const SDL_Rect *src, const SDL_Rect *dst);
+
+        /**
+         * @brief Draws the sprites of the batch. Must be called before
+         *        drawing anything without the batch.
+         *
+         * @param renderer: Rendering target.
+         */
+        void Flush(SDL_Renderer *renderer);
+
+        /**
+         * @brief Keeps the counters of the frame that ended (see the
+         *        getters) and starts counting for the next one. The batch
+         *        must have been flushed.
+         */
+        void EndFrame();
+
+        /**
+         * @return Number of sprites drawn during the last frame.
+         */
+        int GetNbSprites() const;
+
+        /**
+         * @return Number of batches (draw calls) during the last frame.
+         */
+        int GetNbBatches() const;
+
+        /**
+         * @return Number of times a batch was drawn by Flush, rather than
+         *         because the texture changed or the batch was full, during
+         *         the last frame.
+         */
+        int GetNbFlushes() const;
+
+    private:
+        /*
+         * Texture of the sprites of the batch and its size (to compute the
+         * texture coordinates), nullptr when the batch is empty.
+         */
+        SDL_Texture *batchTexture;
+        int textureWidth;
+        int textureHeight;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+#endif
+
+        /* Counters of the current frame. */
+        int nbSprites;
+        int nbBatches;
+        int nbFlushes;
+
+        /* Counters of the last frame. */
+        int lastNbSprites;
+        int lastNbBatches;
+        int lastNbFlushes;
+
+        /**
+         * @brief Draws the sprites of the batch and empties it.
+         *
+         * @param renderer: Rendering target.
+         */
+        void DrawBatch(SDL_Renderer *renderer);
+};
+
+#endif // SPRITEBATCH_H
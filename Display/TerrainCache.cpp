@@ -0,0 +1,206 @@
+/*
+ * Project: Tower Defense
+ * File: TerrainCache.cpp
+ *
+ * Brief: This class keeps the cubes of a level pre-rendered into target
+ *        textures (tiles of TERRAIN_TILE_SIZE pixels). The cubes do not change
+ *        during a wave, so the whole terrain is drawn with a few tiles
+ *        instead of one sprite per cube. The tiles are placed
+ *        relative to the camera and only rebuilt when the zoom or the cubes
+ *        change.
+ */
+
+#include "TerrainCache.h"
+
+/**
+ * @brief Returns the position of the tile containing a position in pixels
+ *        (the division rounds down for negative positions too).
+ */
+static int GetTileCoordinate(int position);
+
+TerrainCache::TerrainCache()
+{
+    tilesRenderer = nullptr;
+    tilesZoom = 0;
+    tilesTerrainVersion = 0;
+}
+
+TerrainCache::~TerrainCache()
+{
+    Clear();
+}
+
+/*
+ * Returns the position of the tile containing a position in pixels.
+ */
+static int GetTileCoordinate(int position)
+{
+    if(position < 0)
+    {
+        return -((-position - 1) / TERRAIN_TILE_SIZE) - 1;
+    }
+
+    return position / TERRAIN_TILE_SIZE;
+}
+
+/*
+ * Draws the cubes of a level with the tiles on the screen.
+ */
+bool TerrainCache::Render(SDL_Renderer *renderer, Camera &camera,
+                          Level &level, Textures &textures,
+                          SpriteBatch &spriteBatch, int screenWidth,
+                          int screenHeight)
+{
+    if(!SDL_RenderTargetSupported(renderer))
+    {
+        return false;
+    }
+
+    /*
+     * The tiles are outdated when the zoom changed or when cubes were added
+     * or moved (placing or selling a tower does not change the cubes).
+     */
+    if(renderer != tilesRenderer || camera.GetZoom() != tilesZoom
+       || level.grid.GetTerrainVersion() != tilesTerrainVersion)
+    {
+        Clear();
+        tilesRenderer = renderer;
+        tilesZoom = camera.GetZoom();
+        tilesTerrainVersion = level.grid.GetTerrainVersion();
+    }
+
+    /* Tiles on the screen (the tiles do not move with the camera). */
+    int minTileX = GetTileCoordinate(-camera.x);
+    int minTileY = GetTileCoordinate(-camera.y);
+    int maxTileX = GetTileCoordinate(screenWidth - 1 - camera.x);
+    int maxTileY = GetTileCoordinate(screenHeight - 1 - camera.y);
+    int nbTiles = (maxTileX - minTileX + 1) * (maxTileY - minTileY + 1);
+
+    if(nbTiles > TERRAIN_MAX_TILES)
+    {
+        return false;
+    }
+
+    if(tiles.size() + nbTiles > TERRAIN_MAX_TILES)
+    {
+        Clear();
+    }
+
+    /* Render the missing tiles before drawing anything. */
+    for(int tileY = minTileY; tileY <= maxTileY; tileY++)
+    {
+        for(int tileX = minTileX; tileX <= maxTileX; tileX++)
+        {
+            unsigned long long key = GetCoordinatesKey(tileX, tileY);
+
+            if(tiles.find(key) == tiles.end())
+            {
+                SDL_Texture *tile = RenderTile(renderer, camera, level,
+                                               textures, spriteBatch, tileX,
+                                               tileY);
+
+                if(tile == nullptr)
+                {
+                    return false;
+                }
+
+                tiles[key] = tile;
+            }
+        }
+    }
+
+    for(int tileY = minTileY; tileY <= maxTileY; tileY++)
+    {
+        for(int tileX = minTileX; tileX <= maxTileX; tileX++)
+        {
+            SDL_Rect dst = {tileX * TERRAIN_TILE_SIZE + camera.x,
+                            tileY * TERRAIN_TILE_SIZE + camera.y,
+                            TERRAIN_TILE_SIZE, TERRAIN_TILE_SIZE};
+
+            spriteBatch.Draw(renderer, tiles[GetCoordinatesKey(tileX, tileY)],
+                             nullptr, &dst);
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Destroys every tile.
+ */
+void TerrainCache::Clear()
+{
+    for(auto &i : tiles)
+    {
+        SDL_DestroyTexture(i.second);
+    }
+
+    tiles.clear();
+}
+
+/*
+ * Creates a tile and draws the cubes over it.
+ */
+SDL_Texture *TerrainCache::RenderTile(SDL_Renderer *renderer, Camera &camera,
+                                      Level &level, Textures &textures,
+                                      SpriteBatch &spriteBatch, int tileX,
+                                      int tileY)
+{
+    SDL_Texture *tile = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                          SDL_TEXTUREACCESS_TARGET,
+                                          TERRAIN_TILE_SIZE,
+                                          TERRAIN_TILE_SIZE);
+
+    if(tile == nullptr)
+    {
+        return nullptr;
+    }
+
+    SDL_Texture *target = SDL_GetRenderTarget(renderer);
+    SDL_Texture *cubeTexture = textures.GetTexture(renderer, TEXTURE_CUBE, 0);
+    int tileScreenX = tileX * TERRAIN_TILE_SIZE + camera.x;
+    int tileScreenY = tileY * TERRAIN_TILE_SIZE + camera.y;
+
+    /* Start from a transparent tile (what was batched goes to the screen). */
+    spriteBatch.Flush(renderer);
+    SDL_SetTextureBlendMode(tile, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderTarget(renderer, tile);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    /* Draw the cubes over the tile, farther diagonals first. */
+    level.grid.GetCubesInScreenRect(tileScreenX, tileScreenY,
+                                    TERRAIN_TILE_SIZE, TERRAIN_TILE_SIZE,
+                                    cubeIndexes);
+    renderQueue.Clear();
+
+    for(auto const &i : cubeIndexes)
+    {
+        const Cube &cube = level.grid.cubes[i];
+
+        renderQueue.Push(RENDER_LAYER_LEVEL, cube.coordX + cube.coordY
+                         - level.grid.GetLowestRowPlusCol(), 0, 0,
+                         RENDER_ITEM_CUBE, i);
+    }
+
+    renderQueue.Sort();
+
+    for(auto const &i : renderQueue.GetItems())
+    {
+        const Cube &cube = level.grid.cubes[i.index];
+        SDL_Rect dst = cube.dst;
+
+        dst.x -= tileScreenX;
+        dst.y -= tileScreenY;
+
+        spriteBatch.Draw(renderer, cubeTexture, &cube.src, &dst);
+    }
+
+    spriteBatch.Flush(renderer);
+    SDL_SetRenderTarget(renderer, target);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+
+    return tile;
+}
+
+int TerrainCache::GetNbTiles() const { return tiles.size(); }
@@ -0,0 +1,103 @@
+#ifndef TERRAINCACHE_H
+#define TERRAINCACHE_H
+
+#include <unordered_map>
+#include <vector>
+#include "Camera.h"
+#include "RenderQueue.h"
+#include "SpriteBatch.h"
+#include "../Level/Level.h"
+#include "../Textures/Textures.h"
+
+/* Width and height in pixels of a tile of the terrain cache. */
+#define TERRAIN_TILE_SIZE 1024
+
+/* Most tiles kept at once (the cache is emptied when it is full). */
+#define TERRAIN_MAX_TILES 48
+
+/**
+ * @brief Cache of the cubes of a level pre-rendered into target textures.
+ *        The terrain is cut in tiles of TERRAIN_TILE_SIZE pixels placed
+ *        relative to the camera position, so panning only moves the tiles.
+ *        A tile is rendered the first time it is on the screen, and every
+ *        tile is rebuilt when the zoom or the cubes change.
+ */
+class TerrainCache
+{
+    public:
+        TerrainCache();
+        virtual ~TerrainCache();
+
+        /* The tiles are owned by the cache and cannot be shared. */
+        TerrainCache(const TerrainCache &) = delete;
+        TerrainCache &operator=(const TerrainCache &) = delete;
+
+        /**
+         * @brief Draws the cubes of a level with the tiles on the screen,
+         *        rendering the missing tiles first. The src and dst of the
+         *        cubes and the projection of the grid must be up to date.
+         *
+         * @param renderer:     Rendering target.
+         * @param camera:       Camera object containing the position on
+         *                      screen and the zoom amount.
+         * @param level:        Level object containing the cubes.
+         * @param textures:     Textures object containing the cube sprites.
+         * @param spriteBatch:  Batch used to draw the cubes and the tiles.
+         * @param screenWidth:  Width of the screen.
+         * @param screenHeight: Height of the screen.
+         *
+         * @return True on success, false if the renderer cannot render to
+         *         textures or if a tile could not be created (nothing is
+         *         drawn and the cubes must be drawn one by one).
+         */
+        bool Render(SDL_Renderer *renderer, Camera &camera, Level &level,
+                    Textures &textures, SpriteBatch &spriteBatch,
+                    int screenWidth, int screenHeight);
+
+        /**
+         * @brief Destroys every tile.
+         */
+        void Clear();
+
+        /**
+         * @return Number of tiles currently cached.
+         */
+        int GetNbTiles() const;
+
+    private:
+        /* Tiles by position (see GetCoordinatesKey). */
+        std::unordered_map<unsigned long long, SDL_Texture *> tiles;
+
+        /*
+         * Renderer, zoom and terrain version of the grid of the cached
+         * tiles.
+         */
+        SDL_Renderer *tilesRenderer;
+        float tilesZoom;
+        unsigned int tilesTerrainVersion;
+
+        /* Cubes of the tile being rendered, in drawing order. */
+        RenderQueue renderQueue;
+        std::vector<int> cubeIndexes;
+
+        /**
+         * @brief Creates a tile and draws the cubes over it.
+         *
+         * @param renderer:    Rendering target.
+         * @param camera:      Camera object containing the position on
+         *                     screen.
+         * @param level:       Level object containing the cubes.
+         * @param textures:    Textures object containing the cube sprites.
+         * @param spriteBatch: Batch used to draw the cubes.
+         * @param tileX:       Position in x of the tile (in tiles).
+         * @param tileY:       Position in y of the tile (in tiles).
+         *
+         * @return Created tile, nullptr on failure.
+         */
+        SDL_Texture *RenderTile(SDL_Renderer *renderer, Camera &camera,
+                                Level &level, Textures &textures,
+                                SpriteBatch &spriteBatch, int tileX,
+                                int tileY);
+};
+
+#endif // TERRAINCACHE_H
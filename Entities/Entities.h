@@ -19,6 +19,12 @@ class Entities
         bool isRendered;
         int orientation;
         SDL_Rect src, dst;
+
+        /*
+         * True when src and dst must be recomputed by the renderer (the
+         * entity moved, turned or was upgraded).
+         */
+        bool isDirty;
 };
 
 #endif // ENTITIES_H
@@ -29,6 +29,7 @@ Tower::Tower(int id, int cubeX, int cubeY)
     this->cubeX = cubeX;
     this->cubeY = cubeY;
     isRendered = false;
+    isDirty = true;
     orientation = 0;
     targetUnit = nullptr;
     isIndicatorActive = false;
@@ -114,6 +115,7 @@ void Tower::ChangeDirection(float towerPosX, float towerPosY,
                             float targetX, float targetY)
 {
     float angle = atan2f(targetY - towerPosY, targetX - towerPosX);
+    int previousOrientation = orientation;
     angle = angle * 180.0f / M_PI;
 
     if(angle > -15.0f && angle <= 15.0f)
@@ -149,6 +151,11 @@ void Tower::ChangeDirection(float towerPosX, float towerPosY,
     {
         orientation = 1;
     }
+
+    if(orientation != previousOrientation)
+    {
+        isDirty = true;
+    }
 }
 
 /*
@@ -163,6 +170,7 @@ bool Tower::UpgradeTower()
         level++;
         LoadAllPresets();
         isUpgraded = true;
+        isDirty = true;
     }
 
     return isUpgraded;
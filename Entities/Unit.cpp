@@ -10,14 +10,22 @@
  */
 
 #include "Unit.h"
+#include "../Level/Reachability.h"
+#include <atomic>
 #include <math.h>
 
+/**
+ * @brief Returns a serial number never returned before.
+ */
+static unsigned int NewSerial();
+
 Unit::Unit(int id, int hp, int movSpeed, int goldValue, int spawnTime)
 {
     src = {0, 0, 0, 0};
     dst = {0, 0, 0, 0};
     orientation = 0;
     isRendered = false;
+    isDirty = true;
     frame = 0;
     this->id = id;
     this->hp = hp;
@@ -33,6 +41,17 @@ Unit::Unit(int id, int hp, int movSpeed, int goldValue, int spawnTime)
     isInNewCube = false;
     isNewPath = true;
     isVisible = false;
+    serial = NewSerial();
+}
+
+/*
+ * Returns a serial number never returned before.
+ */
+static unsigned int NewSerial()
+{
+    static std::atomic<unsigned int> lastSerial(0);
+
+    return ++lastSerial;
 }
 
 /*
@@ -40,19 +59,65 @@ Unit::Unit(int id, int hp, int movSpeed, int goldValue, int spawnTime)
  * to the unit.
  */
 void Unit::GetPath(int startingPointX, int startingPointY, int endingPointX,
-                   int endingPointY, std::vector<Cube> &cubes)
+                   int endingPointY, const std::vector<Cube> &cubes)
 {
     isInNewCube = false;
     path.FindPath(startingPointX, startingPointY, endingPointX, endingPointY,
                   cubes);
 }
 
+/*
+ * Finds a path between two points in a grid (if the path exists) and assigns
+ * it to the unit.
+ */
+void Unit::GetPath(int startingPointX, int startingPointY, int endingPointX,
+                   int endingPointY, const Grid &grid)
+{
+    isInNewCube = false;
+    path.FindPath(startingPointX, startingPointY, endingPointX, endingPointY,
+                  grid);
+}
+
+/*
+ * Assigns to the unit a path between two points, taken from a path cache when
+ * it is known.
+ */
+void Unit::GetPath(int startingPointX, int startingPointY, int endingPointX,
+                   int endingPointY, const Grid &grid, PathCache &pathCache)
+{
+    isInNewCube = false;
+    pathCache.FindPath(startingPointX, startingPointY, endingPointX,
+                       endingPointY, grid, path);
+}
+
+/*
+ * Assigns to the unit the path given by a flow field.
+ */
+void Unit::GetPath(int startingPointX, int startingPointY,
+                   const FlowField &flowField, const Grid &grid)
+{
+    isInNewCube = false;
+    std::vector<int> directions;
+
+    flowField.TracePath(grid, startingPointX, startingPointY, directions);
+    path.SetDirections(directions);
+}
+
+/*
+ * Assigns to the unit a path already found.
+ */
+void Unit::SetPath(const Path &path)
+{
+    isInNewCube = false;
+    this->path = path;
+}
+
 /*
  * Checks if a path exists between two points without assigning it to the unit.
  */
 /* This should probably be transfered to Path.cpp. */
 bool Unit::TestPath(int startingPointX, int startingPointY, int endingPointX,
-                    int endingPointY, std::vector<Cube> &cubes)
+                    int endingPointY, const std::vector<Cube> &cubes)
 {
     bool isPathValid = true;
     Path testPath;
@@ -67,6 +132,30 @@ bool Unit::TestPath(int startingPointX, int startingPointY, int endingPointX,
     return isPathValid;
 }
 
+/*
+ * Checks if a path exists between two points in a grid with a flood fill (no
+ * path is searched).
+ */
+bool Unit::TestPath(int startingPointX, int startingPointY, int endingPointX,
+                    int endingPointY, const Grid &grid)
+{
+    /* The flood fill is kept until the grid or the destination changes. */
+    static thread_local Reachability reachability;
+
+    return reachability.IsReachable(grid, startingPointX, startingPointY,
+                                    endingPointX, endingPointY);
+}
+
+/*
+ * Checks if a path exists between two points, with a path cache.
+ */
+bool Unit::TestPath(int startingPointX, int startingPointY, int endingPointX,
+                    int endingPointY, const Grid &grid, PathCache &pathCache)
+{
+    return pathCache.TestPath(startingPointX, startingPointY,
+                              endingPointX, endingPointY, grid);
+}
+
 /*
  * Makes the unit move with the directions of its path.
  */
@@ -93,6 +182,9 @@ void Unit::Walk(int direction, int cubeLength)
         this->direction = DIRECTION_MIDDLE;
     }
 
+    /* The unit moves, so its rects must be recomputed. */
+    isDirty = true;
+
     /* Move in defined direction. */
     if(this->direction == DIRECTION_MIDDLE)
     {
@@ -204,7 +296,14 @@ void Unit::Walk(int direction, int cubeLength)
 
     if(isInNewCube && quadrant == DIRECTION_MIDDLE)
     {
-        path.GetDirections().erase(path.GetDirections().begin());
+        path.Advance();
         isInNewCube = false;
     }
 }
+
+unsigned int Unit::GetSerial() const { return serial; }
+
+PathView Unit::GetRouteFromCube() const
+{
+    return path.GetDirections().Skip(isInNewCube ? 1 : 0);
+}
@@ -3,6 +3,8 @@
 
 #include "Entities.h"
 #include "../Level/Path.h"
+#include "../Level/FlowField.h"
+#include "../Level/PathCache.h"
 
 /**
  * @brief This class implements units (enemies) that can find a path that they
@@ -33,7 +35,54 @@ class Unit : public Entities
          * @param cubes:          Vector of cubes used to find a path.
          */
         void GetPath(int startingPointX, int startingPointY, int endingPointX,
-                     int endingPointY, std::vector<Cube> &cubes);
+                     int endingPointY, const std::vector<Cube> &cubes);
+
+        /**
+         * @brief Same as above, but uses the coordinate index of a grid.
+         *
+         * @param startingPointX: Starting coordinate of the path in x.
+         * @param startingPointY: Starting coordinate of the path in y.
+         * @param endingPointX:   Ending coordinate of the path in x.
+         * @param endingPointY:   Ending coordinate of the path in x.
+         * @param grid:           Grid used to find a path.
+         */
+        void GetPath(int startingPointX, int startingPointY, int endingPointX,
+                     int endingPointY, const Grid &grid);
+
+        /**
+         * @brief Same as above, but takes the path from a path cache when it
+         *        is known for the current version of the grid (the units of
+         *        a wave then share the same path).
+         *
+         * @param startingPointX: Starting coordinate of the path in x.
+         * @param startingPointY: Starting coordinate of the path in y.
+         * @param endingPointX:   Ending coordinate of the path in x.
+         * @param endingPointY:   Ending coordinate of the path in x.
+         * @param grid:           Grid used to find a path.
+         * @param pathCache:      Cache of the paths found on the grid.
+         */
+        void GetPath(int startingPointX, int startingPointY, int endingPointX,
+                     int endingPointY, const Grid &grid, PathCache &pathCache);
+
+        /**
+         * @brief Assigns to the unit the path given by a flow field (no
+         *        search is done, the path simply follows the flow field).
+         *
+         * @param startingPointX: Starting coordinate of the path in x.
+         * @param startingPointY: Starting coordinate of the path in y.
+         * @param flowField:      Flow field leading to the destination.
+         * @param grid:           Grid the flow field was built on.
+         */
+        void GetPath(int startingPointX, int startingPointY,
+                     const FlowField &flowField, const Grid &grid);
+
+        /**
+         * @brief Assigns to the unit a path already found (for example by
+         *        Path::FindPaths).
+         *
+         * @param path: Path to follow.
+         */
+        void SetPath(const Path &path);
 
         /**
          * @brief Checks if a path exists between two points without assigning
@@ -48,7 +97,40 @@ class Unit : public Entities
          * @return True if path exists, false otherwise.
          */
         bool TestPath(int startingPointX, int startingPointY, int endingPointX,
-                      int endingPointY, std::vector<Cube> &cubes);
+                      int endingPointY, const std::vector<Cube> &cubes);
+
+        /**
+         * @brief Same as above, but checks the grid with a bitset flood fill
+         *        (see Reachability) instead of finding a path. The flood fill
+         *        is reused until the grid or the ending point changes.
+         *
+         * @param startingPointX: Starting coordinate of the path in x.
+         * @param startingPointY: Starting coordinate of the path in y.
+         * @param endingPointX:   Ending coordinate of the path in x.
+         * @param endingPointY:   Ending coordinate of the path in x.
+         * @param grid:           Grid used to find a path.
+         *
+         * @return True if path exists, false otherwise.
+         */
+        bool TestPath(int startingPointX, int startingPointY, int endingPointX,
+                      int endingPointY, const Grid &grid);
+
+        /**
+         * @brief Same as above, but answered by a path cache when the path is
+         *        known for the current version of the grid.
+         *
+         * @param startingPointX: Starting coordinate of the path in x.
+         * @param startingPointY: Starting coordinate of the path in y.
+         * @param endingPointX:   Ending coordinate of the path in x.
+         * @param endingPointY:   Ending coordinate of the path in x.
+         * @param grid:           Grid used to find a path.
+         * @param pathCache:      Cache of the paths found on the grid.
+         *
+         * @return True if path exists, false otherwise.
+         */
+        bool TestPath(int startingPointX, int startingPointY, int endingPointX,
+                      int endingPointY, const Grid &grid,
+                      PathCache &pathCache);
 
         /**
          * @brief Makes the unit move in a direction.
@@ -65,7 +147,24 @@ class Unit : public Entities
          */
         void WalkWithPath(int cubeLength);
 
+        /**
+         * @return Number given to the unit when it was created, never given
+         *         to another unit (copies of the unit keep it). Used to know
+         *         if the units of a vector changed.
+         */
+        unsigned int GetSerial() const;
+
+        /**
+         * @return Directions of the path left from the cube of the unit. The
+         *         path only advances in the middle of a cube, so while the
+         *         unit walks from the border of its cube to the middle, the
+         *         first direction of its path is the one that led it to the
+         *         cube and is skipped.
+         */
+        PathView GetRouteFromCube() const;
+
     private:
+        unsigned int serial;
         bool isNewPath;
         bool isInNewCube;
         int quadrant;
@@ -11,7 +11,7 @@
 
 #include "Cube.h"
 
-Cube::Cube(int x, int y, int z, int id)
+Cube::Cube(int x, int y, int z, int id, bool isWall)
 {
     coordX = x;
     coordY = y;
@@ -20,21 +20,8 @@ Cube::Cube(int x, int y, int z, int id)
     src = {0, 0, 0, 0};
     dst = {0, 0, 0, 0};
     isRendered = false;
-    isWall = false;
+    this->isWall = isWall;
     isHighlighted = false;
-    ResetCosts();
-}
-
-/*
- * Resets the pathfinding attributes (should only be used by Path.cpp).
- */
-void Cube::ResetCosts()
-{
-    gCost = -1;
-    hCost = -1;
-    fCost = -1;
-    shortestPathDir = -1;
-    isVisited = false;
 }
 
 /*
@@ -53,3 +40,5 @@ void Cube::SetId(int id)
 }
 
 int Cube::GetId() { return id; }
+
+bool Cube::IsWall() const { return isWall; }
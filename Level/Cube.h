@@ -5,26 +5,27 @@
 
 /**
  * @brief This class contains cubes used to path find, for rendering and for
- *        unit placement.
+ *        unit placement. The state of a search is not stored in the cubes
+ *        (see PathScratch), a search only reads them. The wall state of a
+ *        cube of a grid is also kept by the grid, so it can only be changed
+ *        with Grid::SetWall.
  */
 class Cube
 {
     public:
         SDL_Rect src, dst;
         int coordX, coordY, coordZ;
-        int gCost, hCost, fCost, shortestPathDir;
-        bool isVisited;
-        bool isWall;
         bool isRendered;
         bool isHighlighted;
 
-        Cube(int x, int y, int z, int id);
-
         /**
-         * @brief Resets the pathfinding attributes (should only be used by
-         *        Path.cpp).
+         * @param x:      Coordinate of the cube in x.
+         * @param y:      Coordinate of the cube in y.
+         * @param z:      Coordinate of the cube in z.
+         * @param id:     Id of the cube.
+         * @param isWall: True if the cube is a wall.
          */
-        void ResetCosts();
+        Cube(int x, int y, int z, int id, bool isWall = false);
 
         /**
          * @brief Sets the id of the cube.
@@ -35,9 +36,13 @@ class Cube
 
         /* Getters. */
         int GetId();
+        bool IsWall() const;
 
     private:
         int id;
+        bool isWall;
+
+        friend class Grid;
 };
 
 #endif // CUBE_H
@@ -0,0 +1,306 @@
+/*
+ * Project: Tower Defense
+ * File: DStarLite.cpp
+ * Unit test file: TestPath.cpp
+ *
+ * Brief: This class implements the D* Lite incremental pathfinding algorithm
+ *        (Koenig & Likhachev). The search is done backward, from the
+ *        destination to the starting point, and every cube keeps two values:
+ *        g (distance to the destination found so far) and rhs (one step
+ *        lookahead of g). When a wall is placed or removed, only the cubes
+ *        around it become inconsistent (g != rhs) and only those, and the
+ *        cubes whose distance really changes, are expanded again. The
+ *        starting point can move between calls (units walking), the km
+ *        value keeps the priorities already in the open set valid.
+ */
+
+#include <climits>
+#include <cstdlib>
+#include <algorithm>
+#include "DStarLite.h"
+#include "Path.h"
+
+/* Cost of an impossible move or distance to an unreachable cube. */
+#define INFINITE_COST (INT_MAX / 4)
+
+/**
+ * @brief Compares two priorities without the index used to break ties.
+ *
+ * @return True if the priority of a is strictly lower than the one of b.
+ */
+template <class T>
+static bool IsKeyLower(const T &a, const T &b)
+{
+    return a.k1 < b.k1 || (a.k1 == b.k1 && a.k2 < b.k2);
+}
+
+DStarLite::DStarLite()
+{
+    gridVersion = 0;
+    goal = -1;
+    start = -1;
+    lastStart = -1;
+    km = 0;
+    nbExpanded = 0;
+    isInitialized = false;
+}
+
+/*
+ * Finds the shortest path from a starting point to the destination, repairing
+ * the previous search when possible.
+ */
+bool DStarLite::FindPath(int startingPointX, int startingPointY,
+                         int endingPointX, int endingPointY, const Grid &grid,
+                         std::vector<int> &directions)
+{
+    int startIndex = grid.GetIndex(startingPointX, startingPointY);
+    int goalIndex = grid.GetIndex(endingPointX, endingPointY);
+
+    directions.clear();
+    nbExpanded = 0;
+
+    /* Check if the starting point and the ending point are valid. */
+    if(startIndex < 0 || goalIndex < 0 || startIndex == goalIndex
+       || grid.IsWall(startIndex) || grid.IsWall(goalIndex))
+    {
+        return false;
+    }
+
+    start = startIndex;
+
+    if(!isInitialized || goalIndex != goal
+       || g.size() != grid.cubes.size()
+       || !grid.GetWallChangesSince(gridVersion, changedCubes))
+    {
+        /* New destination or new grid, search from scratch. */
+        lastStart = start;
+        Initialize(grid, goalIndex);
+    }
+    else
+    {
+        /* Keep the priorities in the open set valid for the new start. */
+        const Coordinates &previous = grid.GetPosition(lastStart);
+        const Coordinates &current = grid.GetPosition(start);
+        km += abs(previous.x - current.x) + abs(previous.y - current.y);
+        lastStart = start;
+
+        /* Only the cubes around the walls that changed are updated. */
+        for(auto const &i : changedCubes)
+        {
+            UpdateNeighbourhood(grid, i);
+        }
+
+        gridVersion = grid.GetVersion();
+    }
+
+    ComputeShortestPath(grid);
+
+    if(g[start] >= INFINITE_COST)
+    {
+        return false;
+    }
+
+    /* Follow the lowest distances from the start to the destination. */
+    const NavGraph &navGraph = grid.GetNavGraph();
+    int index = start;
+
+    for(unsigned int step = 0; index != goal && step < g.size(); step++)
+    {
+        int nextIndex = -1;
+        int nextDirection = -1;
+        int lowestCost = INFINITE_COST;
+        const int *neighbours = navGraph.GetNeighbours(index);
+        const signed char *neighbourDirections =
+            navGraph.GetDirections(index);
+
+        /* On a tie, the first direction (LEFT, RIGHT, UP, DOWN) is taken. */
+        for(int k = 0; k < navGraph.GetDegree(index); k++)
+        {
+            int neighbour = neighbours[k];
+
+            if(g[neighbour] >= INFINITE_COST)
+            {
+                continue;
+            }
+
+            int cost = GetCost(grid, index, neighbour) + g[neighbour];
+
+            if(cost < lowestCost
+               || (cost == lowestCost
+                   && neighbourDirections[k] < nextDirection))
+            {
+                lowestCost = cost;
+                nextIndex = neighbour;
+                nextDirection = neighbourDirections[k];
+            }
+        }
+
+        if(nextIndex < 0)
+        {
+            directions.clear();
+            return false;
+        }
+
+        directions.push_back(nextDirection);
+        index = nextIndex;
+    }
+
+    if(index != goal)
+    {
+        directions.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Resets the search state for a new destination.
+ */
+void DStarLite::Initialize(const Grid &grid, int goal)
+{
+    this->goal = goal;
+    km = 0;
+    g.assign(grid.cubes.size(), INFINITE_COST);
+    rhs.assign(grid.cubes.size(), INFINITE_COST);
+    openSet.Reset(grid.cubes.size());
+    gridVersion = grid.GetVersion();
+    isInitialized = true;
+
+    rhs[goal] = 0;
+    openSet.Push(goal, CalculateKey(grid, goal));
+}
+
+/*
+ * Calculates the priority of a cube.
+ */
+DStarLite::Key DStarLite::CalculateKey(const Grid &grid, int index) const
+{
+    int distance = std::min(g[index], rhs[index]);
+    const Coordinates &position = grid.GetPosition(index);
+    const Coordinates &startPosition = grid.GetPosition(start);
+    Key key = {INFINITE_COST, distance, index};
+
+    if(distance < INFINITE_COST)
+    {
+        key.k1 = distance + km + abs(position.x - startPosition.x)
+                 + abs(position.y - startPosition.y);
+    }
+
+    return key;
+}
+
+/*
+ * Recomputes the rhs value of a cube and updates its place in the open set.
+ */
+void DStarLite::UpdateVertex(const Grid &grid, int index)
+{
+    if(index != goal)
+    {
+        const NavGraph &navGraph = grid.GetNavGraph();
+        const int *neighbours = navGraph.GetNeighbours(index);
+
+        rhs[index] = INFINITE_COST;
+
+        /* Walls cannot be walked to, only the walkable cubes are checked. */
+        for(int k = 0; k < navGraph.GetDegree(index); k++)
+        {
+            int neighbour = neighbours[k];
+
+            if(g[neighbour] < INFINITE_COST)
+            {
+                int cost = GetCost(grid, index, neighbour);
+
+                if(cost < INFINITE_COST)
+                {
+                    rhs[index] = std::min(rhs[index], cost + g[neighbour]);
+                }
+            }
+        }
+    }
+
+    openSet.Remove(index);
+
+    if(g[index] != rhs[index])
+    {
+        openSet.Push(index, CalculateKey(grid, index));
+    }
+}
+
+/*
+ * Updates a cube and its adjacent cubes.
+ */
+void DStarLite::UpdateNeighbourhood(const Grid &grid, int index)
+{
+    const NavGraph &navGraph = grid.GetNavGraph();
+    const int *neighbours = navGraph.GetNeighbours(index);
+
+    UpdateVertex(grid, index);
+
+    for(int k = 0; k < navGraph.GetNbNeighbours(index); k++)
+    {
+        UpdateVertex(grid, neighbours[k]);
+    }
+}
+
+/*
+ * Expands cubes until the starting point is consistent.
+ */
+void DStarLite::ComputeShortestPath(const Grid &grid)
+{
+    while(!openSet.IsEmpty())
+    {
+        Key oldKey = openSet.TopKey();
+
+        if(!IsKeyLower(oldKey, CalculateKey(grid, start))
+           && rhs[start] == g[start])
+        {
+            break;
+        }
+
+        int index = openSet.Top();
+        Key newKey = CalculateKey(grid, index);
+        nbExpanded++;
+
+        if(IsKeyLower(oldKey, newKey))
+        {
+            /* The priority was outdated (the start moved). */
+            openSet.Push(index, newKey);
+        }
+        else if(g[index] > rhs[index])
+        {
+            /* The cube got closer to the destination. */
+            const NavGraph &navGraph = grid.GetNavGraph();
+            const int *neighbours = navGraph.GetNeighbours(index);
+
+            g[index] = rhs[index];
+            openSet.Remove(index);
+
+            for(int k = 0; k < navGraph.GetNbNeighbours(index); k++)
+            {
+                UpdateVertex(grid, neighbours[k]);
+            }
+        }
+        else
+        {
+            /* The cube got further from the destination. */
+            g[index] = INFINITE_COST;
+            UpdateNeighbourhood(grid, index);
+        }
+    }
+}
+
+/*
+ * Returns the cost of moving between two adjacent cubes.
+ */
+int DStarLite::GetCost(const Grid &grid, int from, int to) const
+{
+    if(grid.IsWall(from) || grid.IsWall(to))
+    {
+        return INFINITE_COST;
+    }
+
+    return 1;
+}
+
+int DStarLite::GetNbExpanded() const { return nbExpanded; }
@@ -0,0 +1,117 @@
+#ifndef DSTARLITE_H
+#define DSTARLITE_H
+
+#include <vector>
+#include "Grid.h"
+#include "../Template Helpers/TIndexedHeap.h"
+
+/**
+ * @brief This class implements the D* Lite incremental pathfinding algorithm.
+ *        The search state is kept between calls so that when walls are
+ *        placed or removed, only the affected part of the search is repaired
+ *        instead of searching again from scratch.
+ */
+class DStarLite
+{
+    public:
+        DStarLite();
+
+        /**
+         * @brief Finds the shortest path from a starting point to the
+         *        destination of the planner. The first call (or a call after
+         *        a change of destination or of the grid's structure) does a
+         *        full search, the next calls only repair the search with the
+         *        walls that changed in the grid since the previous call.
+         *
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         * @param grid:           Grid of cubes to extract the path from.
+         * @param directions:     Vector where we store the directions.
+         *
+         * @return True if path is found, false otherwise.
+         */
+        bool FindPath(int startingPointX, int startingPointY,
+                      int endingPointX, int endingPointY, const Grid &grid,
+                      std::vector<int> &directions);
+
+        /**
+         * @return Number of cubes expanded by the last call to FindPath (used
+         *         to verify that repairs are cheaper than full searches).
+         */
+        int GetNbExpanded() const;
+
+    private:
+        /**
+         * @brief Priority of a cube in the open set.
+         *
+         * @param k1:    min(g, rhs) + heuristic + km.
+         * @param k2:    min(g, rhs).
+         * @param index: Index of the cube (used to break ties).
+         */
+        typedef struct Key{
+            int k1;
+            int k2;
+            int index;
+
+            bool operator<(const Key &key) const
+            {
+                if(k1 != key.k1)
+                {
+                    return k1 < key.k1;
+                }
+                else if(k2 != key.k2)
+                {
+                    return k2 < key.k2;
+                }
+
+                return index < key.index;
+            }
+        } Key;
+
+        std::vector<int> g;
+        std::vector<int> rhs;
+        IndexedHeap<Key> openSet;
+        std::vector<int> changedCubes;
+        unsigned int gridVersion;
+        int goal;
+        int start;
+        int lastStart;
+        int km;
+        int nbExpanded;
+        bool isInitialized;
+
+        /**
+         * @brief Resets the search state for a new destination.
+         */
+        void Initialize(const Grid &grid, int goal);
+
+        /**
+         * @brief Calculates the priority of a cube.
+         */
+        Key CalculateKey(const Grid &grid, int index) const;
+
+        /**
+         * @brief Recomputes the rhs value of a cube and updates its place in
+         *        the open set.
+         */
+        void UpdateVertex(const Grid &grid, int index);
+
+        /**
+         * @brief Updates a cube and its adjacent cubes.
+         */
+        void UpdateNeighbourhood(const Grid &grid, int index);
+
+        /**
+         * @brief Expands cubes until the starting point is consistent.
+         */
+        void ComputeShortestPath(const Grid &grid);
+
+        /**
+         * @brief Returns the cost of moving between two adjacent cubes.
+         */
+        int GetCost(const Grid &grid, int from, int to) const;
+};
+
+#endif // DSTARLITE_H
@@ -0,0 +1,224 @@
+/*
+ * Project: Tower Defense
+ * File: FlowField.cpp
+ * Unit test file: TestFlowField.cpp
+ *
+ * Brief: This class implements a flow field shared by all the units going to
+ *        the same destination. A single breadth-first search is done from the
+ *        destination over the walkable cubes and every cube remembers the
+ *        direction to its parent in the search. A unit then reads its next
+ *        step in O(1) instead of running its own A* search. All the moves cost
+ *        the same, so the BFS gives the shortest distance like A* does.
+ *        With several destinations (exits), the search starts from all of
+ *        them at once and every cube leads to its closest exit, for the cost
+ *        of one search.
+ */
+
+#include "FlowField.h"
+
+FlowField::FlowField()
+{
+    gridVersion = 0;
+    isBuilt = false;
+}
+
+/*
+ * Computes the direction and the distance to the destination of every cube.
+ */
+void FlowField::Build(const Grid &grid, int destinationX, int destinationY)
+{
+    Build(grid, std::vector<Coordinates>{{destinationX, destinationY}});
+}
+
+/*
+ * Computes the direction and the distance to the closest destination of every
+ * cube.
+ */
+void FlowField::Build(const Grid &grid,
+                      const std::vector<Coordinates> &destinations)
+{
+    std::vector<int> queue;
+
+    nextDirections.assign(grid.cubes.size(), -1);
+    distances.assign(grid.cubes.size(), -1);
+    gridVersion = grid.GetVersion();
+    this->destinations = destinations;
+    isBuilt = true;
+
+    queue.reserve(grid.cubes.size());
+
+    for(auto const &i : destinations)
+    {
+        int destination = grid.GetIndex(i.x, i.y);
+
+        if(destination >= 0 && !grid.IsWall(destination)
+           && distances[destination] < 0)
+        {
+            queue.push_back(destination);
+            distances[destination] = 0;
+        }
+    }
+
+    for(unsigned int head = 0; head < queue.size(); head++)
+    {
+        const Coordinates &position = grid.GetPosition(queue[head]);
+        int distance = distances[queue[head]] + 1;
+
+        /*
+         * Visit the adjacent cubes. A unit on an adjacent cube walks back
+         * towards the current cube, hence the opposite direction.
+         */
+        for(int k = 0; k < 4; k++)
+        {
+            int i = 0, j = 0;
+            int direction = -1;
+
+            switch(k)
+            {
+            case 0: /* Left adjacent cube. */
+                i = -1;
+                direction = DIRECTION_RIGHT;
+                break;
+            case 1: /* Right adjacent cube. */
+                i = 1;
+                direction = DIRECTION_LEFT;
+                break;
+            case 2: /* Up adjacent cube. */
+                j = -1;
+                direction = DIRECTION_DOWN;
+                break;
+            case 3: /* Down adjacent cube. */
+                j = 1;
+                direction = DIRECTION_UP;
+                break;
+            }
+
+            int index = grid.GetIndex(position.x + i, position.y + j);
+
+            if(index >= 0 && distances[index] < 0 && !grid.IsWall(index))
+            {
+                distances[index] = distance;
+                nextDirections[index] = direction;
+                queue.push_back(index);
+            }
+        }
+    }
+}
+
+/*
+ * Checks if the flow field was built for this destination and for the current
+ * version of the grid.
+ */
+bool FlowField::IsUpToDate(const Grid &grid, int destinationX,
+                           int destinationY) const
+{
+    return isBuilt && gridVersion == grid.GetVersion()
+           && destinations.size() == 1
+           && destinations[0].x == destinationX
+           && destinations[0].y == destinationY;
+}
+
+/*
+ * Checks if the flow field was built for these destinations and for the
+ * current version of the grid.
+ */
+bool FlowField::IsUpToDate(const Grid &grid,
+                           const std::vector<Coordinates> &destinations) const
+{
+    if(!isBuilt || gridVersion != grid.GetVersion()
+       || this->destinations.size() != destinations.size())
+    {
+        return false;
+    }
+
+    for(unsigned int i = 0; i < destinations.size(); i++)
+    {
+        if(this->destinations[i].x != destinations[i].x
+           || this->destinations[i].y != destinations[i].y)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Returns the direction to take from a cube to get closer to the destination.
+ */
+int FlowField::GetDirection(const Grid &grid, int x, int y) const
+{
+    int index = grid.GetIndex(x, y);
+
+    if(index < 0 || index >= static_cast<int>(nextDirections.size()))
+    {
+        return -1;
+    }
+
+    return nextDirections[index];
+}
+
+/*
+ * Returns the number of steps between a cube and the destination.
+ */
+int FlowField::GetDistance(const Grid &grid, int x, int y) const
+{
+    int index = grid.GetIndex(x, y);
+
+    if(index < 0 || index >= static_cast<int>(distances.size()))
+    {
+        return -1;
+    }
+
+    return distances[index];
+}
+
+/*
+ * Follows the flow field from a cube to the destination and stores the
+ * directions taken.
+ */
+bool FlowField::TracePath(const Grid &grid, int startX, int startY,
+                          std::vector<int> &directions) const
+{
+    int distance = GetDistance(grid, startX, startY);
+    int x = startX;
+    int y = startY;
+
+    directions.clear();
+
+    if(distance <= 0)
+    {
+        return false;
+    }
+
+    directions.reserve(distance);
+
+    for(int i = 0; i < distance; i++)
+    {
+        int direction = GetDirection(grid, x, y);
+
+        switch(direction)
+        {
+        case DIRECTION_LEFT:
+            x--;
+            break;
+        case DIRECTION_RIGHT:
+            x++;
+            break;
+        case DIRECTION_UP:
+            y--;
+            break;
+        case DIRECTION_DOWN:
+            y++;
+            break;
+        /* The flow field is outdated, the path is invalid. */
+        default:
+            directions.clear();
+            return false;
+        }
+
+        directions.push_back(direction);
+    }
+
+    return true;
+}
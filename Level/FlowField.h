@@ -0,0 +1,112 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <vector>
+#include "Grid.h"
+#include "Path.h"
+
+/**
+ * @brief This class implements a flow field: for every cube of a grid, the
+ *        direction to take to get one step closer to a destination. It is
+ *        computed once for all the units going to the same destination and
+ *        only needs to be rebuilt when the grid changes.
+ */
+class FlowField
+{
+    public:
+        FlowField();
+
+        /**
+         * @brief Computes the direction and the distance to the destination
+         *        of every cube with a breadth-first search starting at the
+         *        destination.
+         *
+         * @param grid:         Grid of cubes to compute the flow field on.
+         * @param destinationX: Coordinate in x of the destination.
+         * @param destinationY: Coordinate in y of the destination.
+         */
+        void Build(const Grid &grid, int destinationX, int destinationY);
+
+        /**
+         * @brief Same as above, but with several destinations: one
+         *        breadth-first search starts from all of them at once, so
+         *        every cube leads to its closest destination and the cost does
+         *        not depend on the number of destinations.
+         *
+         * @param grid:         Grid of cubes to compute the flow field on.
+         * @param destinations: Coordinates of the destinations (the ones
+         *                      that do not exist or are walls are ignored).
+         */
+        void Build(const Grid &grid,
+                   const std::vector<Coordinates> &destinations);
+
+        /**
+         * @brief Checks if the flow field was built for this destination and
+         *        for the current version of the grid.
+         *
+         * @param grid:         Grid the flow field was built on.
+         * @param destinationX: Coordinate in x of the destination.
+         * @param destinationY: Coordinate in y of the destination.
+         *
+         * @return True if the flow field does not need to be rebuilt.
+         */
+        bool IsUpToDate(const Grid &grid, int destinationX,
+                        int destinationY) const;
+
+        /**
+         * @brief Same as above, with several destinations (in the same order
+         *        as when the flow field was built).
+         */
+        bool IsUpToDate(const Grid &grid,
+                        const std::vector<Coordinates> &destinations) const;
+
+        /**
+         * @brief Returns the direction to take from a cube to get closer to
+         *        the (closest) destination (O(1)).
+         *
+         * @param grid: Grid the flow field was built on.
+         * @param x:    Coordinate of the cube in x.
+         * @param y:    Coordinate of the cube in y.
+         *
+         * @return The direction or -1 if the cube is the destination, does not
+         *         exist or cannot reach the destination.
+         */
+        int GetDirection(const Grid &grid, int x, int y) const;
+
+        /**
+         * @brief Returns the number of steps between a cube and the
+         *        destination (O(1)).
+         *
+         * @param grid: Grid the flow field was built on.
+         * @param x:    Coordinate of the cube in x.
+         * @param y:    Coordinate of the cube in y.
+         *
+         * @return The number of steps or -1 if the destination cannot be
+         *         reached from the cube.
+         */
+        int GetDistance(const Grid &grid, int x, int y) const;
+
+        /**
+         * @brief Follows the flow field from a cube to the destination and
+         *        stores the directions taken (same format as Path).
+         *
+         * @param grid:       Grid the flow field was built on.
+         * @param startX:     Coordinate in x where the path begins.
+         * @param startY:     Coordinate in y where the path begins.
+         * @param directions: Vector where we store the directions.
+         *
+         * @return True if a path is found, false otherwise (also false when
+         *         the starting point is the destination, like FindPath).
+         */
+        bool TracePath(const Grid &grid, int startX, int startY,
+                       std::vector<int> &directions) const;
+
+    private:
+        std::vector<signed char> nextDirections;
+        std::vector<int> distances;
+        unsigned int gridVersion;
+        std::vector<Coordinates> destinations;
+        bool isBuilt;
+};
+
+#endif // FLOWFIELD_H
@@ -7,16 +7,53 @@
  *
  * Brief: This class contains an implementation of a grid containing cubes.
  *        Provides the function to add cubes, move cubes, find a cube using
- *        x and y screen coordinates.
+ *        x and y screen coordinates and find a cube by grid coordinates in
+ *        O(1) with a dense coordinate index.
  */
 
 #include "Grid.h"
 #include <iostream>
+#include <algorithm>
+#include <atomic>
 #include <math.h>
 
+/* Number of wall changes kept in the journal. */
+#define MAX_WALL_CHANGES 512
+
+/**
+ * @brief Returns a version number never returned before, shared by all the
+ *        grids. Two different grids never have the same version (unless one
+ *        is a copy of the other), so data computed from a grid is never
+ *        taken as up to date for another grid.
+ */
+static unsigned int NewVersion();
+
 Grid::Grid()
 {
     lowestRowPlusCol = 0;
+    rowPlusColMin = 0;
+    version = 0;
+    structureVersion = 0;
+    terrainVersion = 0;
+    indexMinX = 0;
+    indexMinY = 0;
+    indexLength = 0;
+    indexHeight = 0;
+    projectionX = 0;
+    projectionY = 0;
+    projectionWidth = 0;
+    projectionHeight = 0;
+    projectionZoom = 1;
+}
+
+/*
+ * Returns a version number never returned before.
+ */
+static unsigned int NewVersion()
+{
+    static std::atomic<unsigned int> lastVersion(0);
+
+    return ++lastVersion;
 }
 
 /*
@@ -26,74 +63,656 @@ void Grid::AddCube(int x, int y, int z, int id)
 {
     Cube cube(x, y, z, id);
     cubes.push_back(cube);
+    positions.push_back({x, y});
+    flags.push_back(0);
 
-    CalculateLowestRowPlusCol();
+    IndexCube(cubes.size() - 1);
+    AddHeight(z);
+    CountRowPlusCol(x + y, 1);
+
+    if(cubes.size() == 1 || x + y < lowestRowPlusCol)
+    {
+        lowestRowPlusCol = x + y;
+    }
+
+    version = NewVersion();
+    structureVersion = version;
+    terrainVersion = version;
+
+    chunks.AddCube(cubes, cubes.size() - 1);
+    navGraph.Resize(cubes.size());
+    LinkCube(cubes.size() - 1);
+}
+
+/*
+ * Reserves memory for a number of cubes.
+ */
+void Grid::Reserve(int nbCubes)
+{
+    cubes.reserve(nbCubes);
+    positions.reserve(nbCubes);
+    flags.reserve(nbCubes);
+}
+
+/*
+ * Replaces all the cubes of the grid at once.
+ */
+void Grid::SetCubes(std::vector<Cube> newCubes)
+{
+    cubes = std::move(newCubes);
+
+    BuildIndex();
 }
 
 /*
  * Moves a cube to the specified coordinates.
  */
-void Grid::MoveCube(Cube cube, int x, int y, int z)
+void Grid::MoveCube(Cube &cube, int x, int y, int z)
 {
+    int index = &cube - cubes.data();
+    int previousRowPlusCol = cube.coordX + cube.coordY;
+
+    /* Remove the cube from its previous cell of the index. */
+    if(GetIndex(cube.coordX, cube.coordY) == index)
+    {
+        coordIndex[(cube.coordY - indexMinY) * indexLength
+                   + cube.coordX - indexMinX] = -1;
+        navGraph.RemoveEdges(index);
+    }
+
+    chunks.RemoveCube(cubes, index);
+
     cube.coordX = x;
     cube.coordY = y;
     cube.coordZ = z;
+    positions[index] = {x, y};
 
-    CalculateLowestRowPlusCol();
+    IndexCube(index);
+    AddHeight(z);
+    chunks.AddCube(cubes, index);
+    LinkCube(index);
+
+    CountRowPlusCol(previousRowPlusCol, -1);
+    CountRowPlusCol(x + y, 1);
+
+    if(x + y < lowestRowPlusCol)
+    {
+        lowestRowPlusCol = x + y;
+    }
+
+    /* The lowest diagonal became empty, find the next one with cubes. */
+    while(nbCubesPerRowPlusCol[lowestRowPlusCol - rowPlusColMin] == 0)
+    {
+        lowestRowPlusCol++;
+    }
+
+    version = NewVersion();
+    structureVersion = version;
+    terrainVersion = version;
 }
 
 /*
- * Calculates the lowest row + column between all cubes (used for rendering).
+ * Turns a cube into a wall or back into a walkable cube.
  */
-void Grid::CalculateLowestRowPlusCol()
+bool Grid::SetWall(int x, int y, bool isWall)
 {
-    bool isFirstIteration = true;
+    Cube *cube = At(x, y);
+
+    if(cube == nullptr)
+    {
+        return false;
+    }
+
+    if(cube->isWall != isWall)
+    {
+        cube->isWall = isWall;
+        flags[cube - cubes.data()] ^= CUBE_FLAG_WALL;
+        version = NewVersion();
+        navGraph.SetWalkable(cube - cubes.data(), !isWall);
+
+        /* Forget the oldest half of the journal when it is full. */
+        if(wallChanges.size() >= MAX_WALL_CHANGES)
+        {
+            structureVersion = wallChanges[MAX_WALL_CHANGES / 2 - 1].version;
+            wallChanges.erase(wallChanges.begin(),
+                              wallChanges.begin() + MAX_WALL_CHANGES / 2);
+        }
+
+        wallChanges.push_back({version, static_cast<int>(cube
+                                                         - cubes.data())});
+    }
+
+    return true;
+}
+
+/*
+ * Returns the cube at the (x, y) grid coordinates.
+ */
+Cube *Grid::At(int x, int y)
+{
+    int index = GetIndex(x, y);
+
+    return index >= 0 ? &cubes[index] : nullptr;
+}
+
+const Cube *Grid::At(int x, int y) const
+{
+    int index = GetIndex(x, y);
+
+    return index >= 0 ? &cubes[index] : nullptr;
+}
+
+/*
+ * Returns the position in the cubes vector of the cube at the (x, y) grid
+ * coordinates, -1 if there is none.
+ */
+int Grid::GetIndex(int x, int y) const
+{
+    int dx = x - indexMinX;
+    int dy = y - indexMinY;
+
+    if(dx < 0 || dy < 0 || dx >= indexLength || dy >= indexHeight)
+    {
+        return -1;
+    }
+
+    return coordIndex[dy * indexLength + dx];
+}
+
+/*
+ * Returns the position in the cubes vector of the cube adjacent to a cube in a
+ * direction, -1 if there is none.
+ */
+int Grid::GetAdjacentIndex(const Cube &cube, int direction) const
+{
+    switch(direction)
+    {
+    case DIRECTION_LEFT:
+        return GetIndex(cube.coordX - 1, cube.coordY);
+    case DIRECTION_RIGHT:
+        return GetIndex(cube.coordX + 1, cube.coordY);
+    case DIRECTION_UP:
+        return GetIndex(cube.coordX, cube.coordY - 1);
+    case DIRECTION_DOWN:
+        return GetIndex(cube.coordX, cube.coordY + 1);
+    }
+
+    return -1;
+}
+
+/*
+ * Rebuilds the coordinate index using the bounds of the cubes.
+ */
+void Grid::BuildIndex()
+{
+    /* The cubes vector was modified directly. */
+    version = NewVersion();
+    structureVersion = version;
+    terrainVersion = version;
+
+    heights.clear();
+    positions.clear();
+    flags.clear();
 
     for(auto const &i : cubes)
     {
-        if(isFirstIteration)
+        AddHeight(i.coordZ);
+        positions.push_back({i.coordX, i.coordY});
+        flags.push_back(i.IsWall() ? CUBE_FLAG_WALL : 0);
+    }
+
+    CalculateLowestRowPlusCol();
+    chunks.Build(cubes);
+
+    if(cubes.empty())
+    {
+        BuildIndex(0, 0, 0, 0);
+        BuildNavGraph();
+        return;
+    }
+
+    int minX = cubes[0].coordX;
+    int maxX = minX;
+    int minY = cubes[0].coordY;
+    int maxY = minY;
+
+    for(auto const &i : cubes)
+    {
+        minX = std::min(minX, i.coordX);
+        maxX = std::max(maxX, i.coordX);
+        minY = std::min(minY, i.coordY);
+        maxY = std::max(maxY, i.coordY);
+    }
+
+    BuildIndex(minX, minY, maxX - minX + 1, maxY - minY + 1);
+    BuildNavGraph();
+}
+
+/*
+ * Rebuilds the coordinate index so that it covers a rectangle.
+ */
+void Grid::BuildIndex(int minX, int minY, int length, int height)
+{
+    indexMinX = minX;
+    indexMinY = minY;
+    indexLength = length;
+    indexHeight = height;
+    coordIndex.assign(length * height, -1);
+
+    /* When two cubes share coordinates, the first one is kept. */
+    for(unsigned int i = 0; i < cubes.size(); i++)
+    {
+        int dx = cubes[i].coordX - minX;
+        int dy = cubes[i].coordY - minY;
+
+        if(dx >= 0 && dy >= 0 && dx < length && dy < height
+           && coordIndex[dy * length + dx] < 0)
+        {
+            coordIndex[dy * length + dx] = i;
+        }
+    }
+}
+
+/*
+ * Rebuilds the navigation graph from scratch.
+ */
+void Grid::BuildNavGraph()
+{
+    navGraph.Clear();
+    navGraph.Resize(cubes.size());
+
+    for(unsigned int i = 0; i < cubes.size(); i++)
+    {
+        const Cube &cube = cubes[i];
+
+        /* Cubes hidden by another cube at the same coordinates are skipped. */
+        if(GetIndex(cube.coordX, cube.coordY) != static_cast<int>(i))
         {
-            lowestRowPlusCol = i.coordX + i.coordY;
-            isFirstIteration = false;
+            continue;
         }
-        else if(i.coordX + i.coordY < lowestRowPlusCol)
+
+        for(int direction = DIRECTION_LEFT; direction <= DIRECTION_DOWN;
+            direction++)
         {
-            lowestRowPlusCol = i.coordX + i.coordY;
+            int neighbour = GetAdjacentIndex(cube, direction);
+
+            if(neighbour >= 0)
+            {
+                navGraph.AddEdge(i, neighbour, direction,
+                                 !IsWall(neighbour));
+            }
         }
     }
 }
 
 /*
- * Finds if there is a cube at the x and y coordinates and returns it.
+ * Links a cube to its adjacent cubes in the navigation graph.
+ */
+void Grid::LinkCube(int index)
+{
+    const Cube &cube = cubes[index];
+
+    if(GetIndex(cube.coordX, cube.coordY) != index)
+    {
+        return;
+    }
+
+    for(int direction = DIRECTION_LEFT; direction <= DIRECTION_DOWN;
+        direction++)
+    {
+        int neighbour = GetAdjacentIndex(cube, direction);
+
+        if(neighbour >= 0)
+        {
+            navGraph.AddEdge(index, neighbour, direction,
+                             !IsWall(neighbour));
+            navGraph.AddEdge(neighbour, index,
+                             GetOppositeDirection(direction), !IsWall(index));
+        }
+    }
+}
+
+/*
+ * Adds a cube to the index, growing the index when needed.
+ */
+void Grid::IndexCube(int index)
+{
+    int x = cubes[index].coordX;
+    int y = cubes[index].coordY;
+
+    if(indexLength == 0 || indexHeight == 0)
+    {
+        BuildIndex(x, y, 1, 1);
+    }
+    else if(x < indexMinX || y < indexMinY || x >= indexMinX + indexLength
+            || y >= indexMinY + indexHeight)
+    {
+        int minX = indexMinX;
+        int minY = indexMinY;
+        int maxX = indexMinX + indexLength - 1;
+        int maxY = indexMinY + indexHeight - 1;
+
+        /*
+         * Grow by at least half of the current size on the side that
+         * overflows so that adding cubes row by row stays linear.
+         */
+        if(x < minX)
+        {
+            minX = std::min(x, minX - indexLength / 2);
+        }
+        else if(x > maxX)
+        {
+            maxX = std::max(x, maxX + indexLength / 2);
+        }
+
+        if(y < minY)
+        {
+            minY = std::min(y, minY - indexHeight / 2);
+        }
+        else if(y > maxY)
+        {
+            maxY = std::max(y, maxY + indexHeight / 2);
+        }
+
+        BuildIndex(minX, minY, maxX - minX + 1, maxY - minY + 1);
+    }
+
+    int &cell = coordIndex[(y - indexMinY) * indexLength + x - indexMinX];
+
+    if(cell < 0)
+    {
+        cell = index;
+    }
+}
+
+/*
+ * Calculates the lowest row + column between all cubes (used for rendering).
+ */
+void Grid::CalculateLowestRowPlusCol()
+{
+    nbCubesPerRowPlusCol.clear();
+    rowPlusColMin = 0;
+
+    for(auto const &i : cubes)
+    {
+        CountRowPlusCol(i.coordX + i.coordY, 1);
+    }
+
+    lowestRowPlusCol = rowPlusColMin;
+
+    /* The counts start at the lowest diagonal, unless they were grown. */
+    while(!cubes.empty()
+          && nbCubesPerRowPlusCol[lowestRowPlusCol - rowPlusColMin] == 0)
+    {
+        lowestRowPlusCol++;
+    }
+}
+
+/*
+ * Adds to the number of cubes of a diagonal.
+ */
+void Grid::CountRowPlusCol(int rowPlusCol, int count)
+{
+    int size = nbCubesPerRowPlusCol.size();
+
+    /*
+     * Grow by at least half of the current size on the side that overflows
+     * so that adding cubes diagonal by diagonal stays linear.
+     */
+    if(size == 0)
+    {
+        rowPlusColMin = rowPlusCol;
+        nbCubesPerRowPlusCol.assign(1, 0);
+    }
+    else if(rowPlusCol < rowPlusColMin)
+    {
+        int minRowPlusCol = std::min(rowPlusCol, rowPlusColMin - size / 2);
+
+        nbCubesPerRowPlusCol.insert(nbCubesPerRowPlusCol.begin(),
+                                    rowPlusColMin - minRowPlusCol, 0);
+        rowPlusColMin = minRowPlusCol;
+    }
+    else if(rowPlusCol >= rowPlusColMin + size)
+    {
+        nbCubesPerRowPlusCol.resize(std::max(rowPlusCol - rowPlusColMin + 1,
+                                             size + size / 2), 0);
+    }
+
+    nbCubesPerRowPlusCol[rowPlusCol - rowPlusColMin] += count;
+}
+
+/*
+ * Adds a z coordinate to the heights of the grid.
+ */
+void Grid::AddHeight(int z)
+{
+    auto position = std::lower_bound(heights.begin(), heights.end(), z);
+
+    if(position == heights.end() || *position != z)
+    {
+        heights.insert(position, z);
+    }
+}
+
+/*
+ * Sets the isometric projection used to render the cubes.
+ */
+void Grid::SetProjection(int originX, int originY, int cubeWidth,
+                         int cubeHeight, float zoom)
+{
+    projectionX = originX;
+    projectionY = originY;
+    projectionWidth = cubeWidth;
+    projectionHeight = cubeHeight;
+    projectionZoom = zoom;
+}
+
+/*
+ * Finds if there is a cube at the x and y screen coordinates and returns it.
  */
 Cube *Grid::GetCubeByCoord(int x, int y)
 {
     Cube *cube = nullptr;
-    double var = sqrt(3)/3;
 
-    for(auto &i : cubes)
+    /*
+     * A step of 1 in x or y moves a cube by half its width and 1/4 of its
+     * height on the screen (see Renderer::SetDstPositions).
+     */
+    int stepX = projectionWidth / 2;
+    int stepY = projectionHeight / 4;
+
+    if(stepX <= 0 || stepY <= 0)
+    {
+        return nullptr;
+    }
+
+    /* Position in x of the point, in steps from the top of the cube (0, 0). */
+    double u = static_cast<double>(x - projectionX - stepX) / stepX;
+
+    for(int z : heights)
+    {
+        int originY = projectionY + z * projectionZoom;
+        double v = static_cast<double>(y - originY) / stepY;
+
+        /*
+         * The top part of the cube (x, y) is the diamond centered on
+         * (u, v) = (x - y, x + y + 1), so rotating by 45 degrees gives the
+         * coordinates of the only cube at this height under the point.
+         */
+        int cubeX = floor((v + u) / 2);
+        int cubeY = floor((v - u) / 2);
+        Cube *candidate = At(cubeX, cubeY);
+
+        /* Keep the cube in front when cubes of several heights overlap. */
+        if(candidate != nullptr && candidate->coordZ == z
+           && (cube == nullptr || cubeX + cubeY > cube->coordX + cube->coordY))
+        {
+            cube = candidate;
+        }
+    }
+
+    return cube;
+}
+
+/*
+ * Returns the chunks that can have cubes on the screen.
+ */
+void Grid::GetVisibleChunks(int screenWidth, int screenHeight,
+                            std::vector<int> &chunkIndexes) const
+{
+    const std::vector<GridChunk> &gridChunks = chunks.GetChunks();
+    int stepX = projectionWidth / 2;
+    int stepY = projectionHeight / 4;
+
+    chunkIndexes.clear();
+
+    for(unsigned int i = 0; i < gridChunks.size(); i++)
     {
+        const GridChunk &chunk = gridChunks[i];
+
+        if(chunk.cubeIndexes.empty())
+        {
+            continue;
+        }
+
+        if(stepX <= 0 || stepY <= 0)
+        {
+            chunkIndexes.push_back(i);
+            continue;
+        }
+
         /*
-         * Isometric search (we only test if the x and y coordinates are
-         * within the top part of a cube).
+         * Screen rectangle covered by the cubes of the chunk: the columns
+         * (x - y) give the position in x and the diagonals (x + y) with the
+         * heights give the position in y.
          */
-        if(y > (i.dst.x + i.dst.w/2)*var + i.dst.y - x*var
-           && y < (i.dst.x + i.dst.w/2)*var + i.dst.y + i.dst.h/2 - x*var
-           && y > -(i.dst.x + i.dst.w/2)*var + i.dst.y + x*var
-           && y < -(i.dst.x + i.dst.w/2)*var + i.dst.y + i.dst.h/2 + x*var)
+        int left = stepX * (chunk.minX - chunk.maxY) + projectionX;
+        int right = stepX * (chunk.maxX - chunk.minY) + projectionX
+                    + projectionWidth;
+        int top = stepY * (chunk.minX + chunk.minY) + projectionY
+                  + chunk.minZ * projectionZoom;
+        int bottom = stepY * (chunk.maxX + chunk.maxY) + projectionY
+                     + chunk.maxZ * projectionZoom + projectionHeight;
+
+        if(right > 0 && left < screenWidth && bottom > 0
+           && top < screenHeight)
+        {
+            chunkIndexes.push_back(i);
+        }
+    }
+}
+
+/*
+ * Returns the cubes drawn over a rectangle of the screen.
+ */
+void Grid::GetCubesInScreenRect(int x, int y, int width, int height,
+                                std::vector<int> &cubeIndexes) const
+{
+    int stepX = projectionWidth / 2;
+    int stepY = projectionHeight / 4;
+
+    cubeIndexes.clear();
+
+    if(stepX <= 0 || stepY <= 0 || heights.empty())
+    {
+        return;
+    }
+
+    /* Columns and diagonals of the cubes that can overlap the rectangle. */
+    int minColumn = floor(double(x - projectionWidth - projectionX) / stepX);
+    int maxColumn = ceil(double(x + width - projectionX) / stepX);
+    int minDiagonal = floor((y - projectionHeight - projectionY
+                             - heights.back() * projectionZoom) / stepY);
+    int maxDiagonal = ceil((y + height - projectionY
+                            - heights.front() * projectionZoom) / stepY);
+
+    /* No cube is outside of the coordinate index. */
+    minColumn = std::max(minColumn, indexMinX - (indexMinY + indexHeight));
+    maxColumn = std::min(maxColumn, indexMinX + indexLength - indexMinY);
+    minDiagonal = std::max(minDiagonal, indexMinX + indexMinY);
+    maxDiagonal = std::min(maxDiagonal, indexMinX + indexLength + indexMinY
+                                        + indexHeight);
+
+    for(int diagonal = minDiagonal; diagonal <= maxDiagonal; diagonal++)
+    {
+        /* The column and the diagonal of a cube have the same parity. */
+        int firstColumn = minColumn + ((minColumn + diagonal) & 1);
+
+        for(int column = firstColumn; column <= maxColumn; column += 2)
         {
-            if(cube == nullptr)
+            int index = GetIndex((diagonal + column) / 2,
+                                 (diagonal - column) / 2);
+
+            if(index < 0)
             {
-                cube = &i;
+                continue;
             }
-            else if(i.coordX + i.coordY > cube->coordX + cube->coordY)
+
+            /* Same position as Renderer::SetDstPositions. */
+            int left = stepX * column + projectionX;
+            int top = stepY * diagonal + projectionY
+                      + cubes[index].coordZ * projectionZoom;
+
+            if(left + projectionWidth > x && left < x + width
+               && top + projectionHeight > y && top < y + height)
             {
-                cube = &i;
+                cubeIndexes.push_back(index);
             }
         }
     }
-
-    return cube;
 }
 
 int Grid::GetLowestRowPlusCol() { return lowestRowPlusCol; }
+
+unsigned int Grid::GetVersion() const { return version; }
+
+unsigned int Grid::GetTerrainVersion() const { return terrainVersion; }
+
+const GridChunks &Grid::GetChunks() const { return chunks; }
+
+const NavGraph &Grid::GetNavGraph() const { return navGraph; }
+
+int Grid::GetIndexMinX() const { return indexMinX; }
+
+int Grid::GetIndexMinY() const { return indexMinY; }
+
+int Grid::GetIndexLength() const { return indexLength; }
+
+int Grid::GetIndexHeight() const { return indexHeight; }
+
+/*
+ * Returns the cubes that had their wall state changed since a version of the
+ * grid.
+ */
+bool Grid::GetWallChangesSince(unsigned int version,
+                               std::vector<int> &cubeIndexes) const
+{
+    cubeIndexes.clear();
+
+    if(version < structureVersion || version > this->version)
+    {
+        return false;
+    }
+
+    /* The version must be one of this grid (not of another grid). */
+    if(version != structureVersion
+       && !std::binary_search(wallChanges.begin(), wallChanges.end(),
+                              WallChange{version, 0},
+                              [](const WallChange &a, const WallChange &b)
+                              {
+                                  return a.version < b.version;
+                              }))
+    {
+        return false;
+    }
+
+    for(auto const &i : wallChanges)
+    {
+        if(i.version > version)
+        {
+            cubeIndexes.push_back(i.index);
+        }
+    }
+
+    return true;
+}
@@ -3,9 +3,29 @@
 
 #include <vector>
 #include "Cube.h"
+#include "GridChunks.h"
+#include "NavGraph.h"
+
+/**
+ * @brief Simple data structure containing a 2D point.
+ *
+ * @param x: Point in x.
+ * @param y: Point in y.
+ */
+typedef struct Coordinates{
+    int x;
+    int y;
+} Coordinates;
+
+/* Bits of the packed flags of a cube (see Grid::IsWall). */
+#define CUBE_FLAG_WALL 1
 
 /**
  * @brief This class contains an implementation of a grid containing cubes.
+ *        Besides the cubes, the grid keeps packed copies of the data read
+ *        by the searches (coordinates and wall flag), so that a search does
+ *        not pull the render rects of every cube it visits through the
+ *        cache.
  */
 class Grid
 {
@@ -24,37 +44,347 @@ class Grid
          */
         void AddCube(int x, int y, int z, int id);
 
+        /**
+         * @brief Reserves memory for a number of cubes, so that adding them
+         *        one by one with AddCube never reallocates the cubes.
+         *
+         * @param nbCubes: Number of cubes the grid will contain.
+         */
+        void Reserve(int nbCubes);
+
+        /**
+         * @brief Replaces all the cubes of the grid at once and builds the
+         *        index, the navigation graph and the lowest row + column in
+         *        a single pass (used to load a level).
+         *
+         * @param newCubes: Cubes of the grid.
+         */
+        void SetCubes(std::vector<Cube> newCubes);
+
         /**
          * @brief Moves a cube to the specified coordinates.
          *
-         * @param cube: Cube to move.
+         * @param cube: Cube to move (must be a cube of this grid).
          * @param x:    Coordinate in x where to move the cube.
          * @param y:    Coordinate in y where to move the cube.
          * @param z:    Coordinate in z where to move the cube.
          */
-        void MoveCube(Cube cube, int x, int y, int z);
+        void MoveCube(Cube &cube, int x, int y, int z);
+
+        /**
+         * @brief Turns a cube into a wall (when a tower is placed on it) or
+         *        back into a walkable cube. Walls must be changed through
+         *        this method so that the grid version is updated.
+         *
+         * @param x:      Coordinate of the cube in x.
+         * @param y:      Coordinate of the cube in y.
+         * @param isWall: True to make the cube a wall.
+         *
+         * @return True if a cube exists at the coordinates.
+         */
+        bool SetWall(int x, int y, bool isWall);
+
+        /**
+         * @brief Returns the cube at the (x, y) grid coordinates in O(1)
+         *        using the coordinate index.
+         *
+         * @param x: Coordinate of the cube in x.
+         * @param y: Coordinate of the cube in y.
+         *
+         * @return Pointer to the cube or nullptr if there is no cube at the
+         *         coordinates.
+         */
+        Cube *At(int x, int y);
+        const Cube *At(int x, int y) const;
+
+        /**
+         * @brief Returns the position in the cubes vector of the cube at the
+         *        (x, y) grid coordinates.
+         *
+         * @param x: Coordinate of the cube in x.
+         * @param y: Coordinate of the cube in y.
+         *
+         * @return Index of the cube or -1 if there is no cube at the
+         *         coordinates.
+         */
+        int GetIndex(int x, int y) const;
+
+        /**
+         * @brief Returns the position in the cubes vector of the cube
+         *        adjacent to a cube in a direction.
+         *
+         * @param cube:      Cube of the grid.
+         * @param direction: Direction of the adjacent cube (DIRECTION_LEFT
+         *                   to DIRECTION_DOWN).
+         *
+         * @return Index of the adjacent cube or -1 if there is none.
+         */
+        int GetAdjacentIndex(const Cube &cube, int direction) const;
+
+        /**
+         * @return Coordinates of the cube at a position of the cubes vector
+         *         (packed copy).
+         */
+        const Coordinates &GetPosition(int index) const
+        {
+            return positions[index];
+        }
+
+        /**
+         * @return True if the cube at a position of the cubes vector is a
+         *         wall (packed copy).
+         */
+        bool IsWall(int index) const
+        {
+            return (flags[index] & CUBE_FLAG_WALL) != 0;
+        }
+
+        /**
+         * @brief Rebuilds the coordinate index from scratch using the bounds
+         *        of the cubes, along with the packed copies of the cubes.
+         *        Must be called after modifying the cubes vector directly
+         *        (AddCube and MoveCube keep the index up to date).
+         */
+        void BuildIndex();
+
+        /**
+         * @brief Sets the isometric projection used to render the cubes
+         *        (see Renderer::SetDstPositions), so that GetCubeByCoord can
+         *        invert it.
+         *
+         * @param originX:    Screen position in x of the cube (0, 0, 0)
+         *                    (camera offset).
+         * @param originY:    Screen position in y of the cube (0, 0, 0)
+         *                    (camera offset).
+         * @param cubeWidth:  Width of a cube on the screen.
+         * @param cubeHeight: Height of a cube on the screen.
+         * @param zoom:       Zoom of the camera (scale of the z coordinate).
+         */
+        void SetProjection(int originX, int originY, int cubeWidth,
+                           int cubeHeight, float zoom);
 
         /**
-         * @brief Finds if there is a cube at the x and y coordinates and
-         *        returns it.
+         * @brief Finds if there is a cube at the x and y screen coordinates
+         *        and returns it. The projection is inverted to find the one
+         *        cube under the point for every height of the grid, so the
+         *        cost does not depend on the number of cubes.
          *
          * @param x: Coordinate of the cube to find in x.
          * @param y: Coordinate of the cube to find in y.
          *
-         * @return Point to the cube found.
+         * @return Point to the cube found (the one in front when cubes
+         *         overlap), nullptr if there is none or if no projection was
+         *         set.
          */
         Cube *GetCubeByCoord(int x, int y);
 
+        /**
+         * @brief Returns the chunks that can have cubes on the screen with
+         *        the projection of the grid. The range of screen positions
+         *        covered by the diagonals (x + y) and the columns (x - y) of
+         *        a chunk is compared to the screen, so the cubes of hidden
+         *        chunks never have to be visited.
+         *
+         * @param screenWidth:  Width of the screen.
+         * @param screenHeight: Height of the screen.
+         * @param chunkIndexes: Vector where we store the positions of the
+         *                      chunks in the chunks vector (every chunk with
+         *                      cubes if no projection was set).
+         */
+        void GetVisibleChunks(int screenWidth, int screenHeight,
+                              std::vector<int> &chunkIndexes) const;
+
+        /**
+         * @brief Returns the cubes drawn over a rectangle of the screen with
+         *        the projection of the grid. Only the columns (x - y) and the
+         *        diagonals (x + y) that can reach the rectangle are looked
+         *        up, so the cost depends on the size of the rectangle and
+         *        not on the number of cubes.
+         *
+         * @param x:           Position in x of the rectangle on the screen.
+         * @param y:           Position in y of the rectangle on the screen.
+         * @param width:       Width of the rectangle.
+         * @param height:      Height of the rectangle.
+         * @param cubeIndexes: Vector where we store the positions of the
+         *                     cubes in the cubes vector (empty if no
+         *                     projection was set).
+         */
+        void GetCubesInScreenRect(int x, int y, int width, int height,
+                                  std::vector<int> &cubeIndexes) const;
+
         /**
          * @brief Calculates the lowest row + column between all cubes
-         *        (used for rendering).
+         *        (used for rendering) from scratch. AddCube, MoveCube and
+         *        BuildIndex keep it up to date.
          */
         void CalculateLowestRowPlusCol();
 
         int GetLowestRowPlusCol();
 
+        /**
+         * @return Version of the grid, changed every time a cube is added,
+         *         moved or has its wall state changed. Used to know when data
+         *         computed from the grid is outdated. Versions increase and
+         *         are unique among all the grids, so data computed from
+         *         another grid is never taken as up to date.
+         */
+        unsigned int GetVersion() const;
+
+        /**
+         * @return Version of the grid when cubes were last added or moved
+         *         (the wall state of the cubes does not change it). Used to
+         *         know when data computed from the cubes alone, like their
+         *         rendering, is outdated.
+         */
+        unsigned int GetTerrainVersion() const;
+
+        /**
+         * @brief Returns the cubes that had their wall state changed since a
+         *        version of the grid (used to repair incremental searches).
+         *
+         * @param version:     Version of the grid to get the changes since.
+         * @param cubeIndexes: Vector where we store the indexes of the changed
+         *                     cubes.
+         *
+         * @return True on success, false if the changes since this version
+         *         are not known anymore or if cubes were added or moved (the
+         *         data computed from the grid must then be rebuilt).
+         */
+        bool GetWallChangesSince(unsigned int version,
+                                 std::vector<int> &cubeIndexes) const;
+
+        /**
+         * @return Partition of the cubes in chunks of GRID_CHUNK_SIZE x
+         *         GRID_CHUNK_SIZE coordinates, kept up to date when cubes are
+         *         added or moved.
+         */
+        const GridChunks &GetChunks() const;
+
+        /**
+         * @return Navigation graph of the walkable adjacent cubes, kept up
+         *         to date when cubes are added, moved or have their wall
+         *         state changed.
+         */
+        const NavGraph &GetNavGraph() const;
+
+        /*
+         * Getters of the rectangle covered by the coordinate index (every
+         * cube is inside of it).
+         */
+        int GetIndexMinX() const;
+        int GetIndexMinY() const;
+        int GetIndexLength() const;
+        int GetIndexHeight() const;
+
     private:
         int lowestRowPlusCol;
+
+        /*
+         * Number of cubes on each diagonal (row + column), starting at the
+         * row + column rowPlusColMin. Keeps the lowest row + column up to
+         * date when the cube on it is moved.
+         */
+        std::vector<int> nbCubesPerRowPlusCol;
+        int rowPlusColMin;
+
+        /**
+         * @brief Adds to the number of cubes of a diagonal, growing the
+         *        counts when the diagonal is outside of them.
+         *
+         * @param rowPlusCol: Row + column of the diagonal.
+         * @param count:      Number of cubes added (negative to remove).
+         */
+        void CountRowPlusCol(int rowPlusCol, int count);
+
+        unsigned int version;
+
+        /* Last version where cubes were added/moved or changes were lost. */
+        unsigned int structureVersion;
+
+        /* Last version where cubes were added or moved. */
+        unsigned int terrainVersion;
+
+        /**
+         * @brief Entry of the wall changes journal.
+         *
+         * @param version: Version of the grid after the change.
+         * @param index:   Index of the cube that changed.
+         */
+        typedef struct WallChange{
+            unsigned int version;
+            int index;
+        } WallChange;
+
+        std::vector<WallChange> wallChanges;
+
+        /*
+         * Dense table of the cube indexes, row by row, covering the
+         * rectangle [indexMinX, indexMinX + indexLength[ x
+         * [indexMinY, indexMinY + indexHeight[. Empty cells contain -1.
+         */
+        std::vector<int> coordIndex;
+        int indexMinX;
+        int indexMinY;
+        int indexLength;
+        int indexHeight;
+
+        /**
+         * @brief Rebuilds the coordinate index so that it covers a rectangle.
+         *
+         * @param minX:   Lowest coordinate in x covered by the index.
+         * @param minY:   Lowest coordinate in y covered by the index.
+         * @param length: Number of coordinates covered in x.
+         * @param height: Number of coordinates covered in y.
+         */
+        void BuildIndex(int minX, int minY, int length, int height);
+
+        /**
+         * @brief Adds a cube to the index, growing the index when the cube is
+         *        outside of its bounds.
+         *
+         * @param index: Position of the cube in the cubes vector.
+         */
+        void IndexCube(int index);
+
+        /* Isometric projection of the cubes (see SetProjection). */
+        int projectionX;
+        int projectionY;
+        int projectionWidth;
+        int projectionHeight;
+        float projectionZoom;
+
+        /*
+         * Packed copies of the coordinates and of the wall state of the
+         * cubes (CUBE_FLAG_ bits), in the same order as the cubes.
+         */
+        std::vector<Coordinates> positions;
+        std::vector<unsigned char> flags;
+
+        /* Every different z coordinate of the cubes, sorted. */
+        std::vector<int> heights;
+
+        /**
+         * @brief Adds a z coordinate to the heights of the grid.
+         *
+         * @param z: Coordinate in z of a cube.
+         */
+        void AddHeight(int z);
+
+        GridChunks chunks;
+        NavGraph navGraph;
+
+        /**
+         * @brief Rebuilds the navigation graph from scratch.
+         */
+        void BuildNavGraph();
+
+        /**
+         * @brief Links a cube to its adjacent cubes in the navigation graph
+         *        (in both directions).
+         *
+         * @param index: Position of the cube in the cubes vector.
+         */
+        void LinkCube(int index);
 };
 
 #endif // GRID_H
@@ -0,0 +1,191 @@
+/*
+ * Project: Tower Defense
+ * File: GridChunks.cpp
+ * Unit test file: TestGridChunks.cpp
+ *
+ * Brief: This class splits the cubes of a grid in chunks of
+ *        GRID_CHUNK_SIZE x GRID_CHUNK_SIZE coordinates and keeps the bounds
+ *        (in x, y and z) of the cubes of every chunk. A whole chunk can
+ *        then be skipped with a single test, for example when it is outside
+ *        of the camera.
+ */
+
+#include <algorithm>
+#include "GridChunks.h"
+
+/**
+ * @brief Returns the coordinate of the chunk containing a coordinate (the
+ *        division rounds down for negative coordinates too).
+ */
+static int GetChunkCoordinate(int coordinate);
+
+GridChunks::GridChunks()
+{
+
+}
+
+/*
+ * Returns the coordinate of the chunk containing a coordinate.
+ */
+static int GetChunkCoordinate(int coordinate)
+{
+    if(coordinate < 0)
+    {
+        return -((-coordinate - 1) / GRID_CHUNK_SIZE) - 1;
+    }
+
+    return coordinate / GRID_CHUNK_SIZE;
+}
+
+/*
+ * Removes every chunk.
+ */
+void GridChunks::Clear()
+{
+    chunks.clear();
+    chunkPositions.clear();
+}
+
+/*
+ * Builds the chunks from scratch.
+ */
+void GridChunks::Build(const std::vector<Cube> &cubes)
+{
+    Clear();
+
+    for(unsigned int i = 0; i < cubes.size(); i++)
+    {
+        AddCube(cubes, i);
+    }
+}
+
+/*
+ * Adds a cube to the chunk containing its coordinates.
+ */
+void GridChunks::AddCube(const std::vector<Cube> &cubes, int index)
+{
+    const Cube &cube = cubes[index];
+    int chunkX = GetChunkCoordinate(cube.coordX);
+    int chunkY = GetChunkCoordinate(cube.coordY);
+    auto position = chunkPositions.find(GetCoordinatesKey(chunkX, chunkY));
+
+    if(position == chunkPositions.end())
+    {
+        int newChunk = chunks.size();
+
+        chunks.push_back({chunkX, chunkY, 0, 0, 0, 0, 0, 0, {}});
+        position = chunkPositions.insert({GetCoordinatesKey(chunkX, chunkY),
+                                          newChunk}).first;
+    }
+
+    GridChunk &chunk = chunks[position->second];
+
+    if(chunk.cubeIndexes.empty())
+    {
+        chunk.minX = chunk.maxX = cube.coordX;
+        chunk.minY = chunk.maxY = cube.coordY;
+        chunk.minZ = chunk.maxZ = cube.coordZ;
+    }
+    else
+    {
+        chunk.minX = std::min(chunk.minX, cube.coordX);
+        chunk.minY = std::min(chunk.minY, cube.coordY);
+        chunk.minZ = std::min(chunk.minZ, cube.coordZ);
+        chunk.maxX = std::max(chunk.maxX, cube.coordX);
+        chunk.maxY = std::max(chunk.maxY, cube.coordY);
+        chunk.maxZ = std::max(chunk.maxZ, cube.coordZ);
+    }
+
+    chunk.cubeIndexes.push_back(index);
+}
+
+/*
+ * Removes a cube from its chunk.
+ */
+void GridChunks::RemoveCube(const std::vector<Cube> &cubes, int index)
+{
+    const Cube &cube = cubes[index];
+    int chunk = GetChunkIndex(cube.coordX, cube.coordY);
+
+    if(chunk < 0)
+    {
+        return;
+    }
+
+    std::vector<int> &cubeIndexes = chunks[chunk].cubeIndexes;
+    auto position = std::find(cubeIndexes.begin(), cubeIndexes.end(), index);
+
+    if(position != cubeIndexes.end())
+    {
+        *position = cubeIndexes.back();
+        cubeIndexes.pop_back();
+        CalculateBounds(cubes, chunks[chunk]);
+    }
+}
+
+/*
+ * Returns the chunks that can contain cubes inside of a rectangle of
+ * coordinates.
+ */
+void GridChunks::GetChunksInRect(int minX, int minY, int maxX, int maxY,
+                                 std::vector<int> &chunkIndexes) const
+{
+    chunkIndexes.clear();
+
+    for(unsigned int i = 0; i < chunks.size(); i++)
+    {
+        const GridChunk &chunk = chunks[i];
+
+        if(!chunk.cubeIndexes.empty() && chunk.minX <= maxX
+           && chunk.maxX >= minX && chunk.minY <= maxY && chunk.maxY >= minY)
+        {
+            chunkIndexes.push_back(i);
+        }
+    }
+}
+
+/*
+ * Returns the position in the chunks vector of the chunk containing
+ * coordinates, -1 if there is none.
+ */
+int GridChunks::GetChunkIndex(int x, int y) const
+{
+    unsigned long long key = GetCoordinatesKey(GetChunkCoordinate(x),
+                                               GetChunkCoordinate(y));
+    auto position = chunkPositions.find(key);
+
+    return position != chunkPositions.end() ? position->second : -1;
+}
+
+/*
+ * Recomputes the bounds of a chunk from its cubes.
+ */
+void GridChunks::CalculateBounds(const std::vector<Cube> &cubes,
+                                 GridChunk &chunk)
+{
+    bool isFirstIteration = true;
+
+    for(auto const &i : chunk.cubeIndexes)
+    {
+        const Cube &cube = cubes[i];
+
+        if(isFirstIteration)
+        {
+            chunk.minX = chunk.maxX = cube.coordX;
+            chunk.minY = chunk.maxY = cube.coordY;
+            chunk.minZ = chunk.maxZ = cube.coordZ;
+            isFirstIteration = false;
+        }
+        else
+        {
+            chunk.minX = std::min(chunk.minX, cube.coordX);
+            chunk.minY = std::min(chunk.minY, cube.coordY);
+            chunk.minZ = std::min(chunk.minZ, cube.coordZ);
+            chunk.maxX = std::max(chunk.maxX, cube.coordX);
+            chunk.maxY = std::max(chunk.maxY, cube.coordY);
+            chunk.maxZ = std::max(chunk.maxZ, cube.coordZ);
+        }
+    }
+}
+
+const std::vector<GridChunk> &GridChunks::GetChunks() const { return chunks; }
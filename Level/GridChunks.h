@@ -0,0 +1,146 @@
+#ifndef GRIDCHUNKS_H
+#define GRIDCHUNKS_H
+
+#include <unordered_map>
+#include <vector>
+#include "Cube.h"
+
+/* Length of a side of a chunk, in cubes. */
+#define GRID_CHUNK_SIZE 32
+
+/**
+ * @brief Returns a key unique to a pair of coordinates, to find something
+ *        by position in a map (the chunks of a grid, the tiles of the
+ *        terrain cache). The coordinates can be negative.
+ *
+ * @param x: Coordinate in x.
+ * @param y: Coordinate in y.
+ *
+ * @return Key of the coordinates.
+ */
+inline unsigned long long GetCoordinatesKey(int x, int y)
+{
+    return static_cast<unsigned long long>(static_cast<unsigned int>(x)) << 32
+           | static_cast<unsigned int>(y);
+}
+
+/**
+ * @brief Square of GRID_CHUNK_SIZE x GRID_CHUNK_SIZE coordinates of a grid
+ *        and the cubes inside of it.
+ *
+ * @param chunkX:      Coordinate of the chunk in x (in chunks).
+ * @param chunkY:      Coordinate of the chunk in y (in chunks).
+ * @param minX:        Lowest coordinate in x of its cubes.
+ * @param minY:        Lowest coordinate in y of its cubes.
+ * @param minZ:        Lowest coordinate in z of its cubes.
+ * @param maxX:        Highest coordinate in x of its cubes.
+ * @param maxY:        Highest coordinate in y of its cubes.
+ * @param maxZ:        Highest coordinate in z of its cubes.
+ * @param cubeIndexes: Positions of its cubes in the cubes vector.
+ */
+typedef struct GridChunk{
+    int chunkX;
+    int chunkY;
+    int minX;
+    int minY;
+    int minZ;
+    int maxX;
+    int maxY;
+    int maxZ;
+    std::vector<int> cubeIndexes;
+} GridChunk;
+
+/**
+ * @brief Partition of the cubes of a grid in chunks, with the bounds of the
+ *        cubes of every chunk. Code that only needs the cubes of a region
+ *        (for example the ones visible by the camera) tests the bounds of
+ *        the chunks instead of every cube.
+ *
+ * @note The chunks are kept up to date by the Grid that owns them. They
+ *       only partition the cubes: a chunk is never compressed or unloaded,
+ *       even far from the camera. The searches, the flow field and the
+ *       placement map read the whole grid, and the positions of the cubes in
+ *       the cubes vector are kept by the paths, the route index and the
+ *       planners, so every cube stays in memory. The level file lists the
+ *       cubes row by row, so it cannot be read one chunk at a time either.
+ */
+class GridChunks
+{
+    public:
+        GridChunks();
+
+        /**
+         * @brief Removes every chunk.
+         */
+        void Clear();
+
+        /**
+         * @brief Builds the chunks from scratch.
+         *
+         * @param cubes: Cubes of the grid.
+         */
+        void Build(const std::vector<Cube> &cubes);
+
+        /**
+         * @brief Adds a cube to the chunk containing its coordinates.
+         *
+         * @param cubes: Cubes of the grid.
+         * @param index: Position of the cube in the cubes vector.
+         */
+        void AddCube(const std::vector<Cube> &cubes, int index);
+
+        /**
+         * @brief Removes a cube from its chunk (called before the cube is
+         *        moved).
+         *
+         * @param cubes: Cubes of the grid.
+         * @param index: Position of the cube in the cubes vector.
+         */
+        void RemoveCube(const std::vector<Cube> &cubes, int index);
+
+        /**
+         * @brief Returns the chunks that can contain cubes inside of a
+         *        rectangle of coordinates.
+         *
+         * @param minX:         Lowest coordinate in x of the rectangle.
+         * @param minY:         Lowest coordinate in y of the rectangle.
+         * @param maxX:         Highest coordinate in x of the rectangle.
+         * @param maxY:         Highest coordinate in y of the rectangle.
+         * @param chunkIndexes: Vector where we store the positions of the
+         *                      chunks in the chunks vector.
+         */
+        void GetChunksInRect(int minX, int minY, int maxX, int maxY,
+                             std::vector<int> &chunkIndexes) const;
+
+        /**
+         * @return Position in the chunks vector of the chunk containing
+         *         coordinates, -1 if there is no cube in this chunk.
+         */
+        int GetChunkIndex(int x, int y) const;
+
+        /**
+         * @return Chunks of the grid. A chunk whose cubes were all moved
+         *         away stays in the vector, without cubes.
+         */
+        const std::vector<GridChunk> &GetChunks() const;
+
+    private:
+        std::vector<GridChunk> chunks;
+
+        /*
+         * Position of each chunk in the chunks vector, by chunk coordinates
+         * (see GetCoordinatesKey).
+         */
+        std::unordered_map<unsigned long long, int> chunkPositions;
+
+        /**
+         * @brief Recomputes the bounds of a chunk from its cubes.
+         *
+         * @param cubes: Cubes of the grid.
+         * @param chunk: Chunk to update.
+         */
+        void CalculateBounds(const std::vector<Cube> &cubes,
+                             GridChunk &chunk);
+};
+
+#endif // GRIDCHUNKS_H
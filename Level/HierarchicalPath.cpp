@@ -0,0 +1,657 @@
+/*
+ * Project: Tower Defense
+ * File: HierarchicalPath.cpp
+ * Unit test file: TestHierarchicalPath.cpp
+ *
+ * Brief: This class implements hierarchical pathfinding (HPA*, Botea et al.).
+ *        - The grid is split into clusters of CLUSTER_SIZE x CLUSTER_SIZE
+ *          cubes.
+ *        - Along every border between two clusters, each run of cubes that
+ *          are walkable on both sides is an entrance: one transition in the
+ *          middle of short runs, one at each end of long runs.
+ *        - The cubes of the transitions are the nodes of an abstract graph.
+ *          Nodes of the same cluster are linked by their distance inside of
+ *          the cluster (breadth-first search), nodes of a transition by one
+ *          step.
+ *        A search adds the starting and the ending points to the graph of
+ *        their cluster, runs A* on the graph, then finds the steps between
+ *        two consecutive nodes inside of their cluster only.
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include "HierarchicalPath.h"
+#include "Path.h"
+
+/* Runs of at least this many cubes get one transition at each end. */
+#define ENTRANCE_SPLIT_LENGTH 6
+
+HierarchicalPath::HierarchicalPath()
+{
+    minX = 0;
+    minY = 0;
+    nbClustersX = 0;
+    nbClustersY = 0;
+    nbRebuiltClusters = 0;
+    gridVersion = 0;
+    isBuilt = false;
+}
+
+/*
+ * Finds a path from a starting point to an ending point with the abstract
+ * graph of the clusters.
+ */
+bool HierarchicalPath::FindPath(int startingPointX, int startingPointY,
+                                int endingPointX, int endingPointY,
+                                const Grid &grid, std::vector<int> &directions)
+{
+    int start = grid.GetIndex(startingPointX, startingPointY);
+    int end = grid.GetIndex(endingPointX, endingPointY);
+
+    directions.clear();
+
+    /* Check if the starting point and the ending point are valid. */
+    if(start < 0 || end < 0 || start == end || grid.IsWall(start)
+       || grid.IsWall(end))
+    {
+        return false;
+    }
+
+    Update(grid);
+
+    const Cube &startCube = grid.cubes[start];
+    const Cube &endCube = grid.cubes[end];
+    int startCluster = GetCluster(startCube);
+    int endCluster = GetCluster(endCube);
+    int index = -1;
+
+    /* Distances from the starting point and to the ending point. */
+    SearchCluster(grid, start, startDistances);
+    SearchCluster(grid, end, endDistances);
+
+    scratch.Prepare(grid.cubes.size());
+    parents.resize(grid.cubes.size());
+
+    auto Relax = [&](int from, int to, int cost)
+    {
+        if(scratch.IsClosed(to))
+        {
+            return;
+        }
+
+        int gCost = scratch.GetGCost(from) + cost;
+
+        if(!scratch.IsSeen(to) || gCost < scratch.GetGCost(to))
+        {
+            const Coordinates &position = grid.GetPosition(to);
+            int hCost = abs(endCube.coordX - position.x)
+                        + abs(endCube.coordY - position.y);
+
+            scratch.SetCosts(to, gCost, hCost, -1);
+            parents[to] = from;
+            scratch.openSet.Push(to, {gCost + hCost, hCost, to});
+        }
+    };
+
+    int hCost = abs(endCube.coordX - startCube.coordX)
+                + abs(endCube.coordY - startCube.coordY);
+
+    scratch.SetCosts(start, 0, hCost, -1);
+    parents[start] = -1;
+    scratch.openSet.Push(start, {hCost, hCost, start});
+
+    /* A* on the abstract graph. */
+    while((index = scratch.openSet.Pop()) >= 0 && index != end)
+    {
+        const Cube &cube = grid.cubes[index];
+        int cluster = GetCluster(cube);
+        int slot = nodeSlots[index];
+
+        scratch.Close(index);
+
+        if(cluster == endCluster
+           && endDistances[GetLocalPosition(cube)] >= 0)
+        {
+            Relax(index, end, endDistances[GetLocalPosition(cube)]);
+        }
+
+        if(index == start && slot < 0)
+        {
+            for(auto const &i : clusters[startCluster].nodes)
+            {
+                int distance = startDistances[GetLocalPosition(grid.cubes[i])];
+
+                if(distance >= 0)
+                {
+                    Relax(index, i, distance);
+                }
+            }
+        }
+
+        if(slot >= 0)
+        {
+            const Cluster &current = clusters[cluster];
+            int nbNodes = current.nodes.size();
+
+            for(int i = 0; i < nbNodes; i++)
+            {
+                int distance = current.distances[slot * nbNodes + i];
+
+                if(i != slot && distance >= 0)
+                {
+                    Relax(index, current.nodes[i], distance);
+                }
+            }
+
+            for(auto const &i : current.partners[slot])
+            {
+                Relax(index, i, 1);
+            }
+        }
+    }
+
+    if(index != end)
+    {
+        return false;
+    }
+
+    /* Nodes of the abstract path, from the start to the end. */
+    std::vector<int> waypoints;
+
+    for(int i = end; i >= 0; i = parents[i])
+    {
+        waypoints.push_back(i);
+    }
+
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    /* Find the steps between the nodes. */
+    for(unsigned int i = 1; i < waypoints.size(); i++)
+    {
+        const Cube &from = grid.cubes[waypoints[i - 1]];
+        const Cube &to = grid.cubes[waypoints[i]];
+
+        if(GetCluster(from) != GetCluster(to))
+        {
+            /* Transition between two clusters, always a single step. */
+            if(to.coordX < from.coordX)
+            {
+                directions.push_back(DIRECTION_LEFT);
+            }
+            else if(to.coordX > from.coordX)
+            {
+                directions.push_back(DIRECTION_RIGHT);
+            }
+            else if(to.coordY < from.coordY)
+            {
+                directions.push_back(DIRECTION_UP);
+            }
+            else
+            {
+                directions.push_back(DIRECTION_DOWN);
+            }
+        }
+        else if(!RefineSegment(grid, waypoints[i - 1], waypoints[i],
+                               directions))
+        {
+            directions.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Computes the clusters again if the grid changed.
+ */
+void HierarchicalPath::Update(const Grid &grid)
+{
+    if(isBuilt && gridVersion == grid.GetVersion())
+    {
+        return;
+    }
+
+    if(!isBuilt || nodeSlots.size() != grid.cubes.size()
+       || !grid.GetWallChangesSince(gridVersion, changedCubes))
+    {
+        Build(grid);
+        return;
+    }
+
+    isClusterDirty.assign(clusters.size(), false);
+
+    for(auto const &i : changedCubes)
+    {
+        const Cube &cube = grid.cubes[i];
+
+        if(grid.GetIndex(cube.coordX, cube.coordY) != i)
+        {
+            continue;
+        }
+
+        int cluster = GetCluster(cube);
+        int clusterX = cluster % nbClustersX;
+        int clusterY = cluster / nbClustersX;
+        int localX = (cube.coordX - minX) % CLUSTER_SIZE;
+        int localY = (cube.coordY - minY) % CLUSTER_SIZE;
+
+        MarkDirty(clusterX, clusterY);
+
+        /*
+         * A cube on the side of a cluster may change the entrances, and so
+         * the nodes of the cluster on the other side.
+         */
+        if(localX == CLUSTER_SIZE - 1 && BuildBorder(grid, cluster, true))
+        {
+            MarkDirty(clusterX + 1, clusterY);
+        }
+
+        if(localX == 0 && clusterX > 0
+           && BuildBorder(grid, cluster - 1, true))
+        {
+            MarkDirty(clusterX - 1, clusterY);
+        }
+
+        if(localY == CLUSTER_SIZE - 1 && BuildBorder(grid, cluster, false))
+        {
+            MarkDirty(clusterX, clusterY + 1);
+        }
+
+        if(localY == 0 && clusterY > 0
+           && BuildBorder(grid, cluster - nbClustersX, false))
+        {
+            MarkDirty(clusterX, clusterY - 1);
+        }
+    }
+
+    for(unsigned int i = 0; i < clusters.size(); i++)
+    {
+        if(isClusterDirty[i])
+        {
+            BuildCluster(grid, i);
+        }
+    }
+
+    gridVersion = grid.GetVersion();
+}
+
+/*
+ * Computes every border and every cluster.
+ */
+void HierarchicalPath::Build(const Grid &grid)
+{
+    int maxX = 0;
+    int maxY = 0;
+
+    /* Bounds of the cubes (the coordinate index may be larger). */
+    for(unsigned int i = 0; i < grid.cubes.size(); i++)
+    {
+        const Cube &cube = grid.cubes[i];
+
+        if(i == 0 || cube.coordX < minX)
+        {
+            minX = cube.coordX;
+        }
+
+        if(i == 0 || cube.coordY < minY)
+        {
+            minY = cube.coordY;
+        }
+
+        if(i == 0 || cube.coordX > maxX)
+        {
+            maxX = cube.coordX;
+        }
+
+        if(i == 0 || cube.coordY > maxY)
+        {
+            maxY = cube.coordY;
+        }
+    }
+
+    nbClustersX = grid.cubes.empty() ? 0
+                  : (maxX - minX) / CLUSTER_SIZE + 1;
+    nbClustersY = grid.cubes.empty() ? 0
+                  : (maxY - minY) / CLUSTER_SIZE + 1;
+
+    int nbClusters = nbClustersX * nbClustersY;
+
+    clusters.assign(nbClusters, Cluster());
+    rightBorders.assign(nbClusters, std::vector<Transition>());
+    bottomBorders.assign(nbClusters, std::vector<Transition>());
+    nodeSlots.assign(grid.cubes.size(), -1);
+
+    for(int i = 0; i < nbClusters; i++)
+    {
+        BuildBorder(grid, i, true);
+        BuildBorder(grid, i, false);
+    }
+
+    for(int i = 0; i < nbClusters; i++)
+    {
+        BuildCluster(grid, i);
+    }
+
+    gridVersion = grid.GetVersion();
+    isBuilt = true;
+}
+
+/*
+ * Computes the transitions of the border on the right of a cluster or below
+ * it.
+ */
+bool HierarchicalPath::BuildBorder(const Grid &grid, int cluster,
+                                   bool isRight)
+{
+    int clusterX = cluster % nbClustersX;
+    int clusterY = cluster / nbClustersX;
+    std::vector<Transition> &border = isRight ? rightBorders[cluster]
+                                              : bottomBorders[cluster];
+    std::vector<Transition> previous;
+    int runStart = -1;
+
+    previous.swap(border);
+
+    /* The clusters on the right side and at the bottom have no border. */
+    if((isRight && clusterX == nbClustersX - 1)
+       || (!isRight && clusterY == nbClustersY - 1))
+    {
+        return !previous.empty();
+    }
+
+    /* Returns the transition at a position along the border, if walkable. */
+    auto GetTransition = [&](int i, Transition &transition)
+    {
+        int x = minX + clusterX * CLUSTER_SIZE;
+        int y = minY + clusterY * CLUSTER_SIZE;
+
+        if(i >= CLUSTER_SIZE)
+        {
+            return false;
+        }
+
+        if(isRight)
+        {
+            transition.first = grid.GetIndex(x + CLUSTER_SIZE - 1, y + i);
+            transition.second = grid.GetIndex(x + CLUSTER_SIZE, y + i);
+        }
+        else
+        {
+            transition.first = grid.GetIndex(x + i, y + CLUSTER_SIZE - 1);
+            transition.second = grid.GetIndex(x + i, y + CLUSTER_SIZE);
+        }
+
+        return transition.first >= 0 && transition.second >= 0
+               && !grid.cubes[transition.first].IsWall()
+               && !grid.cubes[transition.second].IsWall();
+    };
+
+    Transition transition = {-1, -1};
+
+    for(int i = 0; i <= CLUSTER_SIZE; i++)
+    {
+        bool isOpen = GetTransition(i, transition);
+
+        if(isOpen && runStart < 0)
+        {
+            runStart = i;
+        }
+        else if(!isOpen && runStart >= 0)
+        {
+            int length = i - runStart;
+
+            if(length < ENTRANCE_SPLIT_LENGTH)
+            {
+                GetTransition(runStart + length / 2, transition);
+                border.push_back(transition);
+            }
+            else
+            {
+                GetTransition(runStart, transition);
+                border.push_back(transition);
+                GetTransition(i - 1, transition);
+                border.push_back(transition);
+            }
+
+            runStart = -1;
+        }
+    }
+
+    if(border.size() != previous.size())
+    {
+        return true;
+    }
+
+    for(unsigned int i = 0; i < border.size(); i++)
+    {
+        if(border[i].first != previous[i].first
+           || border[i].second != previous[i].second)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Computes the entrances of a cluster and the distances between them.
+ */
+void HierarchicalPath::BuildCluster(const Grid &grid, int cluster)
+{
+    Cluster &current = clusters[cluster];
+    int clusterX = cluster % nbClustersX;
+    int clusterY = cluster / nbClustersX;
+
+    for(auto const &i : current.nodes)
+    {
+        nodeSlots[i] = -1;
+    }
+
+    current.nodes.clear();
+    current.partners.clear();
+
+    auto AddNode = [&](int cube, int partner)
+    {
+        if(nodeSlots[cube] < 0)
+        {
+            nodeSlots[cube] = current.nodes.size();
+            current.nodes.push_back(cube);
+            current.partners.push_back(std::vector<int>());
+        }
+
+        current.partners[nodeSlots[cube]].push_back(partner);
+    };
+
+    /* Entrances of the four borders of the cluster. */
+    for(auto const &i : rightBorders[cluster])
+    {
+        AddNode(i.first, i.second);
+    }
+
+    for(auto const &i : bottomBorders[cluster])
+    {
+        AddNode(i.first, i.second);
+    }
+
+    if(clusterX > 0)
+    {
+        for(auto const &i : rightBorders[cluster - 1])
+        {
+            AddNode(i.second, i.first);
+        }
+    }
+
+    if(clusterY > 0)
+    {
+        for(auto const &i : bottomBorders[cluster - nbClustersX])
+        {
+            AddNode(i.second, i.first);
+        }
+    }
+
+    /* Distances between the entrances, inside of the cluster only. */
+    int nbNodes = current.nodes.size();
+
+    current.distances.assign(nbNodes * nbNodes, -1);
+
+    for(int i = 0; i < nbNodes; i++)
+    {
+        SearchCluster(grid, current.nodes[i], bfsDistances);
+
+        for(int j = 0; j < nbNodes; j++)
+        {
+            const Cube &cube = grid.cubes[current.nodes[j]];
+            current.distances[i * nbNodes + j] =
+                bfsDistances[GetLocalPosition(cube)];
+        }
+    }
+
+    nbRebuiltClusters++;
+}
+
+/*
+ * Marks a cluster to be computed again.
+ */
+void HierarchicalPath::MarkDirty(int clusterX, int clusterY)
+{
+    if(clusterX >= 0 && clusterX < nbClustersX
+       && clusterY >= 0 && clusterY < nbClustersY)
+    {
+        isClusterDirty[clusterY * nbClustersX + clusterX] = true;
+    }
+}
+
+/*
+ * Breadth-first search from a cube that stays inside of its cluster.
+ */
+void HierarchicalPath::SearchCluster(const Grid &grid, int cube,
+                                     std::vector<int> &distances)
+{
+    const Cube &origin = grid.cubes[cube];
+    int cluster = GetCluster(origin);
+    int x0 = minX + (cluster % nbClustersX) * CLUSTER_SIZE;
+    int y0 = minY + (cluster / nbClustersX) * CLUSTER_SIZE;
+
+    distances.assign(CLUSTER_SIZE * CLUSTER_SIZE, -1);
+    bfsQueue.clear();
+    bfsQueue.push_back(cube);
+    distances[GetLocalPosition(origin)] = 0;
+
+    for(unsigned int i = 0; i < bfsQueue.size(); i++)
+    {
+        const Cube &current = grid.cubes[bfsQueue[i]];
+        int distance = distances[GetLocalPosition(current)];
+
+        for(int direction = DIRECTION_LEFT; direction <= DIRECTION_DOWN;
+            direction++)
+        {
+            int x = current.coordX + (direction == DIRECTION_RIGHT)
+                    - (direction == DIRECTION_LEFT);
+            int y = current.coordY + (direction == DIRECTION_DOWN)
+                    - (direction == DIRECTION_UP);
+
+            if(x < x0 || x >= x0 + CLUSTER_SIZE
+               || y < y0 || y >= y0 + CLUSTER_SIZE)
+            {
+                continue;
+            }
+
+            int neighbour = grid.GetIndex(x, y);
+
+            if(neighbour >= 0 && !grid.cubes[neighbour].IsWall())
+            {
+                int local = (y - y0) * CLUSTER_SIZE + (x - x0);
+
+                if(distances[local] < 0)
+                {
+                    distances[local] = distance + 1;
+                    bfsQueue.push_back(neighbour);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Adds to a path the directions to go from a cube to another cube of the same
+ * cluster.
+ */
+bool HierarchicalPath::RefineSegment(const Grid &grid, int from, int to,
+                                     std::vector<int> &directions)
+{
+    SearchCluster(grid, to, bfsDistances);
+
+    int index = from;
+    int cluster = GetCluster(grid.cubes[to]);
+
+    if(bfsDistances[GetLocalPosition(grid.cubes[from])] < 0)
+    {
+        return false;
+    }
+
+    /* Follow the distances down to the destination of the segment. */
+    while(index != to)
+    {
+        const Cube &cube = grid.cubes[index];
+        int distance = bfsDistances[GetLocalPosition(cube)];
+        int direction = DIRECTION_LEFT;
+
+        for(; direction <= DIRECTION_DOWN; direction++)
+        {
+            int neighbour = grid.GetIndex(
+                cube.coordX + (direction == DIRECTION_RIGHT)
+                - (direction == DIRECTION_LEFT),
+                cube.coordY + (direction == DIRECTION_DOWN)
+                - (direction == DIRECTION_UP));
+
+            if(neighbour >= 0 && GetCluster(grid.cubes[neighbour]) == cluster
+               && bfsDistances[GetLocalPosition(grid.cubes[neighbour])]
+                  == distance - 1)
+            {
+                index = neighbour;
+                break;
+            }
+        }
+
+        directions.push_back(direction);
+    }
+
+    return true;
+}
+
+/*
+ * Returns the cluster containing a cube.
+ */
+int HierarchicalPath::GetCluster(const Cube &cube) const
+{
+    return ((cube.coordY - minY) / CLUSTER_SIZE) * nbClustersX
+           + (cube.coordX - minX) / CLUSTER_SIZE;
+}
+
+/*
+ * Returns the position of a cube in its cluster.
+ */
+int HierarchicalPath::GetLocalPosition(const Cube &cube) const
+{
+    return ((cube.coordY - minY) % CLUSTER_SIZE) * CLUSTER_SIZE
+           + (cube.coordX - minX) % CLUSTER_SIZE;
+}
+
+int HierarchicalPath::GetNbRebuiltClusters() const
+{
+    return nbRebuiltClusters;
+}
+
+int HierarchicalPath::GetNbNodes() const
+{
+    int nbNodes = 0;
+
+    for(auto const &i : clusters)
+    {
+        nbNodes += i.nodes.size();
+    }
+
+    return nbNodes;
+}
@@ -0,0 +1,178 @@
+#ifndef HIERARCHICALPATH_H
+#define HIERARCHICALPATH_H
+
+#include <vector>
+#include "Grid.h"
+#include "PathScratch.h"
+
+/* Length of a side of a cluster, in cubes. */
+#define CLUSTER_SIZE 16
+
+/**
+ * @brief This class implements hierarchical pathfinding (HPA*) for large
+ *        grids. The grid is split into square clusters, the entrances between
+ *        adjacent clusters and the distances between the entrances of a
+ *        cluster are precomputed. A search is first done on this much smaller
+ *        graph of entrances, then only the clusters crossed by the result are
+ *        searched cube by cube. When walls change, only the clusters (and the
+ *        borders) containing the changed cubes are computed again.
+ */
+class HierarchicalPath
+{
+    public:
+        HierarchicalPath();
+
+        /**
+         * @brief Finds a path from a starting point to an ending point. The
+         *        clusters are updated first if the grid changed.
+         *
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         * @param grid:           Grid of cubes to extract the path from.
+         * @param directions:     Vector where we store the directions.
+         *
+         * @return True if path is found, false otherwise.
+         *
+         * @note A path is found whenever A* finds one, but it may be a few
+         *       steps longer since it goes through the entrances.
+         */
+        bool FindPath(int startingPointX, int startingPointY,
+                      int endingPointX, int endingPointY, const Grid &grid,
+                      std::vector<int> &directions);
+
+        /**
+         * @brief Computes the clusters again if the grid changed since they
+         *        were last computed (only the changed clusters when the
+         *        changes are known, see Grid::GetWallChangesSince).
+         *
+         * @param grid: Grid of cubes to compute the clusters on.
+         */
+        void Update(const Grid &grid);
+
+        /**
+         * @return Number of clusters computed since the creation of the
+         *         object (used to verify that updates are local).
+         */
+        int GetNbRebuiltClusters() const;
+
+        /**
+         * @return Number of entrances (nodes of the abstract graph).
+         */
+        int GetNbNodes() const;
+
+    private:
+        /**
+         * @brief Pair of adjacent walkable cubes on both sides of a border.
+         *
+         * @param first:  Cube in the cluster on the left or above.
+         * @param second: Cube in the cluster on the right or below.
+         */
+        typedef struct Transition{
+            int first;
+            int second;
+        } Transition;
+
+        /**
+         * @brief Entrances of a cluster and the distances between them.
+         *
+         * @param nodes:     Cubes of the cluster that are entrances.
+         * @param partners:  For every entrance, the cubes of other clusters
+         *                   it leads to.
+         * @param distances: Distance between two entrances (nodes.size()
+         *                   squared values, -1 if not connected inside the
+         *                   cluster).
+         */
+        typedef struct Cluster{
+            std::vector<int> nodes;
+            std::vector<std::vector<int>> partners;
+            std::vector<int> distances;
+        } Cluster;
+
+        std::vector<Cluster> clusters;
+
+        /* Borders between a cluster and the cluster on its right/below. */
+        std::vector<std::vector<Transition>> rightBorders;
+        std::vector<std::vector<Transition>> bottomBorders;
+
+        /* Position of every cube in the nodes of its cluster, -1 if none. */
+        std::vector<int> nodeSlots;
+
+        int minX;
+        int minY;
+        int nbClustersX;
+        int nbClustersY;
+        int nbRebuiltClusters;
+        unsigned int gridVersion;
+        bool isBuilt;
+        std::vector<int> changedCubes;
+        std::vector<bool> isClusterDirty;
+
+        /* Buffers of the searches. */
+        std::vector<int> bfsDistances;
+        std::vector<int> bfsQueue;
+        std::vector<int> startDistances;
+        std::vector<int> endDistances;
+        std::vector<int> parents;
+        PathScratch scratch;
+
+        /**
+         * @brief Computes every border and every cluster.
+         */
+        void Build(const Grid &grid);
+
+        /**
+         * @brief Computes the transitions of the border on the right of a
+         *        cluster (isRight true) or below it.
+         *
+         * @return True if the transitions changed.
+         */
+        bool BuildBorder(const Grid &grid, int cluster, bool isRight);
+
+        /**
+         * @brief Computes the entrances of a cluster and the distances
+         *        between them.
+         */
+        void BuildCluster(const Grid &grid, int cluster);
+
+        /**
+         * @brief Marks a cluster to be computed again (ignored if the cluster
+         *        does not exist).
+         */
+        void MarkDirty(int clusterX, int clusterY);
+
+        /**
+         * @brief Breadth-first search from a cube that stays inside of its
+         *        cluster.
+         *
+         * @param grid:      Grid of cubes.
+         * @param cube:      Index of the cube to start from.
+         * @param distances: Vector where we store the distance to every cube
+         *                   of the cluster (by position in the cluster), -1
+         *                   if not reachable.
+         */
+        void SearchCluster(const Grid &grid, int cube,
+                           std::vector<int> &distances);
+
+        /**
+         * @brief Adds to a path the directions to go from a cube to another
+         *        cube of the same cluster.
+         *
+         * @return True if the cubes are connected inside of the cluster.
+         */
+        bool RefineSegment(const Grid &grid, int from, int to,
+                           std::vector<int> &directions);
+
+        /**
+         * @brief Returns the cluster containing a cube.
+         */
+        int GetCluster(const Cube &cube) const;
+
+        /**
+         * @brief Returns the position of a cube in its cluster.
+         */
+        int GetLocalPosition(const Cube &cube) const;
+};
+
+#endif // HIERARCHICALPATH_H
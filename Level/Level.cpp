@@ -15,6 +15,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * @brief Advances to a section in a level file.
@@ -25,10 +26,22 @@
 static void AdvanceToSection(std::ifstream &levelFile,
                              std::string sectionName);
 
+/**
+ * @brief Loads the "x, y" points of a level file section, up to the end of
+ *        the section. A point at (0, 0) is loaded if the section is empty.
+ *
+ * @param levelFile: Level file reference (already at the section).
+ * @param points:    Vector where we store the points.
+ */
+static void LoadPoints(std::ifstream &levelFile,
+                       std::vector<Coordinates> &points);
+
 Level::Level()
 {
     spawnPoint = {0, 0};
     destination = {0, 0};
+    spawnPoints.push_back(spawnPoint);
+    destinations.push_back(destination);
     timeBetweenWaves = 10;
     isSrcUpdated = false;
 }
@@ -53,6 +66,237 @@ static void AdvanceToSection(std::ifstream &levelFile, std::string sectionName)
     }
 }
 
+/*
+ * Loads the points of a level file section.
+ */
+static void LoadPoints(std::ifstream &levelFile,
+                       std::vector<Coordinates> &points)
+{
+    std::string line;
+    char separator;
+
+    points.clear();
+
+    while(std::getline(levelFile, line) && line.compare("}") != 0)
+    {
+        std::istringstream iline(line);
+        Coordinates point;
+
+        if(iline >> point.x >> separator >> point.y)
+        {
+            points.push_back(point);
+        }
+    }
+
+    if(points.empty())
+    {
+        points.push_back({0, 0});
+    }
+}
+
+/*
+ * Rebuilds the flow field leading to the destinations when it is outdated.
+ */
+void Level::UpdateFlowField()
+{
+    if(destinations.size() > 1)
+    {
+        if(!flowField.IsUpToDate(grid, destinations))
+        {
+            flowField.Build(grid, destinations);
+        }
+    }
+    else if(!flowField.IsUpToDate(grid, destination.x, destination.y))
+    {
+        flowField.Build(grid, destination.x, destination.y);
+    }
+}
+
+/*
+ * Checks if placing a tower on a cube would block the path of a spawn point.
+ */
+bool Level::IsPlacementBlocking(int x, int y)
+{
+    placementMaps.resize(spawnPoints.size());
+
+    for(unsigned int i = 0; i < spawnPoints.size(); i++)
+    {
+        const Coordinates &spawn = spawnPoints[i];
+        bool isChecked = false;
+
+        /* The maps of the spawn points listed twice are the same. */
+        for(unsigned int j = 0; j < i && !isChecked; j++)
+        {
+            isChecked = spawnPoints[j].x == spawn.x
+                        && spawnPoints[j].y == spawn.y;
+        }
+
+        if(isChecked)
+        {
+            continue;
+        }
+
+        if(!placementMaps[i].IsUpToDate(grid, spawn.x, spawn.y, destinations))
+        {
+            placementMaps[i].Build(grid, spawn.x, spawn.y, destinations);
+        }
+
+        if(placementMaps[i].IsBlocking(grid, x, y))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Finds the path of every unit with one batch of searches.
+ */
+void Level::FindUnitPaths()
+{
+    std::vector<PathQuery> queries;
+    std::vector<int> queryUnits;
+    std::vector<Path> paths;
+
+    /*
+     * One multi-source search gives the paths to the closest exits: the flow
+     * field is only traced once per starting cube (the units mostly start
+     * on the spawns) and the units on the same cube get a copy of that path.
+     */
+    if(destinations.size() > 1)
+    {
+        std::unordered_map<unsigned long long, Path> tracedPaths;
+
+        UpdateFlowField();
+
+        for(auto &i : units)
+        {
+            unsigned long long key = GetCoordinatesKey(i.cubeX, i.cubeY);
+            auto tracedPath = tracedPaths.find(key);
+
+            if(tracedPath == tracedPaths.end())
+            {
+                std::vector<int> directions;
+
+                flowField.TracePath(grid, i.cubeX, i.cubeY, directions);
+                tracedPath = tracedPaths.insert({key, Path()}).first;
+                tracedPath->second.SetDirections(directions);
+            }
+
+            i.SetPath(tracedPath->second);
+        }
+
+        routeIndex.Build(units, grid);
+        return;
+    }
+
+    /* Only the paths not known for the current grid are searched. */
+    for(unsigned int i = 0; i < units.size(); i++)
+    {
+        Path path;
+
+        if(pathCache.Lookup(units[i].cubeX, units[i].cubeY,
+                            destination.x, destination.y, grid, path))
+        {
+            units[i].SetPath(path);
+        }
+        else
+        {
+            queries.push_back({units[i].cubeX, units[i].cubeY,
+                               destination.x, destination.y});
+            queryUnits.push_back(i);
+        }
+    }
+
+    if(!queries.empty())
+    {
+        Path::FindPaths(queries, grid, paths);
+    }
+
+    for(unsigned int i = 0; i < queries.size(); i++)
+    {
+        pathCache.Store(queries[i].startingPointX, queries[i].startingPointY,
+                        queries[i].endingPointX, queries[i].endingPointY,
+                        grid, paths[i]);
+        units[queryUnits[i]].SetPath(paths[i]);
+    }
+
+    routeIndex.Build(units, grid);
+}
+
+/*
+ * Finds a new path for the units affected by a change of the wall state of a
+ * cube.
+ */
+int Level::ReplanAffectedUnits(int x, int y)
+{
+    std::vector<int> affectedUnits;
+    const Cube *cube = grid.At(x, y);
+
+    if(cube == nullptr)
+    {
+        return 0;
+    }
+
+    if(!routeIndex.IsUpToDate(units))
+    {
+        routeIndex.Build(units, grid);
+    }
+
+    if(cube->IsWall())
+    {
+        routeIndex.GetUnits(x, y, grid, affectedUnits);
+    }
+    else
+    {
+        /*
+         * The removed wall can only make routes shorter: the units without a
+         * route or with a route longer than the distance to their closest
+         * destination are replanned.
+         */
+        UpdateFlowField();
+
+        for(unsigned int i = 0; i < units.size(); i++)
+        {
+            int distance = flowField.GetDistance(grid, units[i].cubeX,
+                                                 units[i].cubeY);
+            int nbSteps = units[i].GetRouteFromCube().size();
+
+            if(distance > 0 && (nbSteps == 0 || nbSteps > distance))
+            {
+                affectedUnits.push_back(i);
+            }
+        }
+    }
+
+    for(auto const &i : affectedUnits)
+    {
+        FindUnitPath(units[i]);
+        routeIndex.SetRoute(i, units[i].cubeX, units[i].cubeY,
+                            units[i].GetRouteFromCube(), grid);
+    }
+
+    return affectedUnits.size();
+}
+
+/*
+ * Finds the path of a unit from its cube to the destination.
+ */
+void Level::FindUnitPath(Unit &unit)
+{
+    if(destinations.size() > 1)
+    {
+        UpdateFlowField();
+        unit.GetPath(unit.cubeX, unit.cubeY, flowField, grid);
+    }
+    else
+    {
+        unit.GetPath(unit.cubeX, unit.cubeY, destination.x, destination.y,
+                     grid, pathCache);
+    }
+}
+
 /*
  * Loads wave information from a level file.
  */
@@ -70,6 +314,7 @@ void Level::LoadWave(int levelId, int wave)
     int goldValue = 0;
     int timeBetween = 0;
     int spawnTime = 0;
+    int spawn = 0;
 
     fileName.append(std::to_string(levelId));
     fileName.append(".txt");
@@ -96,16 +341,28 @@ void Level::LoadWave(int levelId, int wave)
         iline >> nbUnits >> id >> hp >> movSpeed >> goldValue >> timeBetween
               >> spawnTime;
 
+        /* Optional column: spawn point of the units (the first one if none). */
+        spawn = 0;
+        iline >> spawn;
+        iline.clear();
+
+        if(spawn < 0 || spawn >= (int)spawnPoints.size())
+        {
+            std::cout << "Level file: wave " << wave << " uses spawn point "
+                      << spawn << " which does not exist, units skipped.\n";
+            continue;
+        }
+
+        Coordinates unitSpawnPoint = spawnPoints[spawn];
+
         for(int i = 0; i < nbUnits; i++)
         {
             Unit unit(id, hp, movSpeed, goldValue,
                       spawnTime + i * timeBetween);
-            unit.cubeX = spawnPoint.x;
-            unit.cubeY = spawnPoint.y;
+            unit.cubeX = unitSpawnPoint.x;
+            unit.cubeY = unitSpawnPoint.y;
             units.push_back(unit);
         }
-
-        iline.clear();
     }
 
     levelFile.close();
@@ -118,8 +375,6 @@ void Level::LoadSpawnPointAndDestination(int levelId)
 {
     std::ifstream levelFile;
     std::string fileName = "levels/";
-    std::string line;
-    char separator;
 
     fileName.append(std::to_string(levelId));
     fileName.append(".txt");
@@ -128,18 +383,14 @@ void Level::LoadSpawnPointAndDestination(int levelId)
 
     /* Load spawn points. */
     AdvanceToSection(levelFile, "SPAWNPOINTS {");
-
-    std::getline(levelFile, line);
-    std::istringstream iline(line);
-    iline >> spawnPoint.x >> separator >> spawnPoint.y;
+    LoadPoints(levelFile, spawnPoints);
 
     /* Load destination points. */
     AdvanceToSection(levelFile, "DESTINATIONS {");
+    LoadPoints(levelFile, destinations);
 
-    std::getline(levelFile, line);
-    iline.clear();
-    iline.str(line);
-    iline >> destination.x >> separator >> destination.y;
+    spawnPoint = spawnPoints[0];
+    destination = destinations[0];
 
     levelFile.close();
 }
@@ -157,6 +408,7 @@ void Level::LoadLevel(int levelId)
     int z = 0;
     int id = 0;
     char separator;
+    std::vector<Cube> cubes;
 
     fileName.append(std::to_string(levelId));
     fileName.append(".txt");
@@ -188,7 +440,7 @@ void Level::LoadLevel(int levelId)
         {
             iline >> y >> z >> id >> separator;
 
-            grid.AddCube(x, y, z, id);
+            cubes.push_back(Cube(x, y, z, id));
 
             if(separator == ';')
             {
@@ -203,6 +455,13 @@ void Level::LoadLevel(int levelId)
     }
 
     levelFile.close();
+
+    /*
+     * Build the grid once all the cubes are read, instead of updating it
+     * after each cube.
+     */
+    grid.SetCubes(std::move(cubes));
+
     LoadSpawnPointAndDestination(levelId);
 }
 
@@ -3,20 +3,13 @@
 
 #include <vector>
 #include "Grid.h"
+#include "FlowField.h"
+#include "PlacementMap.h"
+#include "PathCache.h"
+#include "RouteIndex.h"
 #include "../Entities/Unit.h"
 #include "../Entities/Tower.h"
 
-/**
- * @brief Simple data structure containing a 2D point.
- *
- * @param x: Point in x.
- * @param y: Point in y.
- */
-typedef struct Coordinates{
-    int x;
-    int y;
-} Coordinates;
-
 /**
  * @brief Level class used for loading and storing level informations from file
  *        such as wave data, cube data, etc.
@@ -25,8 +18,20 @@ class Level
 {
     public:
         Grid grid;
+        FlowField flowField;
+        std::vector<PlacementMap> placementMaps;
+        PathCache pathCache;
+        RouteIndex routeIndex;
         Coordinates spawnPoint;
         Coordinates destination;
+
+        /*
+         * Every spawn point and destination (exit) of the level. spawnPoint
+         * and destination are their first entries; with more than one
+         * destination, the units go to their closest one.
+         */
+        std::vector<Coordinates> spawnPoints;
+        std::vector<Coordinates> destinations;
         std::vector<Unit> units;
         std::vector<Tower> towers;
         int timeBetweenWaves;
@@ -42,12 +47,61 @@ class Level
         void LoadLevel(int levelId);
 
         /**
-         * @brief Loads the spawn points and destination points of the level.
+         * @brief Loads the spawn points and destination points of the level
+         *        (one "x, y" line per point in each section).
          *
          * @param levelId: Id of the level to load from.
          */
         void LoadSpawnPointAndDestination(int levelId);
 
+        /**
+         * @brief Rebuilds the flow field leading to the destinations if the
+         *        grid (walls, towers) or the destinations changed since it was
+         *        last built. All the destinations are done in one pass.
+         */
+        void UpdateFlowField();
+
+        /**
+         * @brief Checks if placing a tower on a cube would leave no path
+         *        between a spawn point and the destinations. There is one
+         *        placement map per distinct spawn point, rebuilt only when the
+         *        grid changed since the last call, otherwise this is a few
+         *        reads (cheap enough to be called on every hover).
+         *
+         * @param x: Coordinate of the cube in x.
+         * @param y: Coordinate of the cube in y.
+         *
+         * @return True if the tower would block the path of a spawn point.
+         */
+        bool IsPlacementBlocking(int x, int y);
+
+        /**
+         * @brief Finds the path of every unit, from its cube to the
+         *        destination. The paths already in the path cache are reused,
+         *        the others are found with one batch of searches spread over
+         *        several threads (see Path::FindPaths) and added to the cache.
+         *        With several destinations, the paths are traced on the flow
+         *        field instead (one search for all the units and exits).
+         */
+        void FindUnitPaths();
+
+        /**
+         * @brief Finds a new path for the units affected by a tower placed or
+         *        sold on a cube (call it after changing the wall state of the
+         *        cube). When a tower is placed, only the units whose route
+         *        crosses the cube are replanned (see RouteIndex). When a tower
+         *        is sold, every route stays valid, so only the units without
+         *        a route or whose route is now longer than the shortest one
+         *        (given by the flow field) are replanned. The other units
+         *        keep their route.
+         *
+         * @param x: Coordinate of the cube in x.
+         * @param y: Coordinate of the cube in y.
+         *
+         * @return Number of units replanned.
+         */
+        int ReplanAffectedUnits(int x, int y);
+
         /**
          * @brief Loads wave information from a level file.
          *
@@ -110,6 +164,15 @@ class Level
          * @return The planet's name.
          */
         std::string GetPlanetName(int planetId);
+
+    private:
+        /**
+         * @brief Finds the path of a unit from its cube to the destination
+         *        (or its closest destination when there are several).
+         *
+         * @param unit: Unit to find the path of.
+         */
+        void FindUnitPath(Unit &unit);
 };
 
 #endif // LEVEL_H
@@ -0,0 +1,134 @@
+/*
+ * Project: Tower Defense
+ * File: NavGraph.cpp
+ * Unit test file: TestNavGraph.cpp
+ *
+ * Brief: This class contains the navigation graph of a grid, compiled from
+ *        the cubes: the adjacent cubes of every cube are stored in a flat
+ *        array of indexes (4 slots per cube), with the walkable ones first and
+ *        their number (degree). A search simply loops over the first degree
+ *        slots of a cube. Turning a cube into a wall swaps it out of the
+ *        walkable slots of its neighbours, so the graph is never rebuilt
+ *        when towers are placed or sold.
+ */
+
+#include <algorithm>
+#include "NavGraph.h"
+
+NavGraph::NavGraph()
+{
+
+}
+
+/*
+ * Removes every node.
+ */
+void NavGraph::Clear()
+{
+    neighbours.clear();
+    directions.clear();
+    nbNeighbours.clear();
+    degrees.clear();
+}
+
+/*
+ * Adds nodes without neighbours.
+ */
+void NavGraph::Resize(int nbNodes)
+{
+    neighbours.resize(nbNodes * NAV_GRAPH_MAX_DEGREE, -1);
+    directions.resize(nbNodes * NAV_GRAPH_MAX_DEGREE, -1);
+    nbNeighbours.resize(nbNodes, 0);
+    degrees.resize(nbNodes, 0);
+}
+
+/*
+ * Adds a neighbour to a node.
+ */
+void NavGraph::AddEdge(int node, int neighbour, int direction, bool isWalkable)
+{
+    int slot = nbNeighbours[node];
+
+    if(slot >= NAV_GRAPH_MAX_DEGREE)
+    {
+        return;
+    }
+
+    neighbours[node * NAV_GRAPH_MAX_DEGREE + slot] = neighbour;
+    directions[node * NAV_GRAPH_MAX_DEGREE + slot] = direction;
+    nbNeighbours[node]++;
+
+    /* Keep the walkable neighbours first. */
+    if(isWalkable)
+    {
+        SwapSlots(node, slot, degrees[node]);
+        degrees[node]++;
+    }
+}
+
+/*
+ * Removes every neighbour of a node, in both directions.
+ */
+void NavGraph::RemoveEdges(int node)
+{
+    for(int i = 0; i < nbNeighbours[node]; i++)
+    {
+        int neighbour = neighbours[node * NAV_GRAPH_MAX_DEGREE + i];
+        const int *slots = GetNeighbours(neighbour);
+        int slot = std::find(slots, slots + nbNeighbours[neighbour], node)
+                   - slots;
+
+        /* Move the node to the non walkable neighbours, then to the end. */
+        if(slot < degrees[neighbour])
+        {
+            degrees[neighbour]--;
+            SwapSlots(neighbour, slot, degrees[neighbour]);
+            slot = degrees[neighbour];
+        }
+
+        nbNeighbours[neighbour]--;
+        SwapSlots(neighbour, slot, nbNeighbours[neighbour]);
+    }
+
+    nbNeighbours[node] = 0;
+    degrees[node] = 0;
+}
+
+/*
+ * Moves a node among the walkable or non walkable neighbours of each of its
+ * neighbours.
+ */
+void NavGraph::SetWalkable(int node, bool isWalkable)
+{
+    for(int i = 0; i < nbNeighbours[node]; i++)
+    {
+        int neighbour = neighbours[node * NAV_GRAPH_MAX_DEGREE + i];
+        const int *slots = GetNeighbours(neighbour);
+        int slot = std::find(slots, slots + nbNeighbours[neighbour], node)
+                   - slots;
+
+        if(isWalkable && slot >= degrees[neighbour])
+        {
+            SwapSlots(neighbour, slot, degrees[neighbour]);
+            degrees[neighbour]++;
+        }
+        else if(!isWalkable && slot < degrees[neighbour])
+        {
+            degrees[neighbour]--;
+            SwapSlots(neighbour, slot, degrees[neighbour]);
+        }
+    }
+}
+
+/*
+ * Swaps two neighbour slots of a node.
+ */
+void NavGraph::SwapSlots(int node, int first, int second)
+{
+    int offset = node * NAV_GRAPH_MAX_DEGREE;
+
+    std::swap(neighbours[offset + first], neighbours[offset + second]);
+    std::swap(directions[offset + first], directions[offset + second]);
+}
+
+int NavGraph::GetNbNodes() const { return nbNeighbours.size(); }
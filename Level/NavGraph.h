@@ -0,0 +1,130 @@
+#ifndef NAVGRAPH_H
+#define NAVGRAPH_H
+
+#include <vector>
+
+/**
+ * @brief Constants for all the possible directions in which an adjacent tile
+ *        can be.
+ */
+enum DIRECTION{DIRECTION_LEFT, DIRECTION_RIGHT, DIRECTION_UP, DIRECTION_DOWN,
+               DIRECTION_MIDDLE};
+
+/* Largest number of adjacent cubes of a cube. */
+#define NAV_GRAPH_MAX_DEGREE 4
+
+/**
+ * @brief Navigation graph of a grid: for every cube (node), the indexes of
+ *        its adjacent cubes in one flat array (NAV_GRAPH_MAX_DEGREE slots per
+ *        node), the walkable ones first. The searches read the walkable
+ *        neighbours of a cube directly instead of looking up its 4 adjacent
+ *        coordinates. When a cube becomes a wall (or walkable again), only
+ *        the slots of its neighbours are reordered, in place.
+ *
+ * @note The graph is kept up to date by the Grid that owns it.
+ */
+class NavGraph
+{
+    public:
+        NavGraph();
+
+        /**
+         * @brief Removes every node.
+         */
+        void Clear();
+
+        /**
+         * @brief Adds nodes without neighbours until there are nbNodes nodes.
+         *
+         * @param nbNodes: Number of nodes.
+         */
+        void Resize(int nbNodes);
+
+        /**
+         * @brief Adds a neighbour to a node (in one direction only).
+         *
+         * @param node:       Index of the node.
+         * @param neighbour:  Index of the adjacent node.
+         * @param direction:  Direction from the node to the neighbour.
+         * @param isWalkable: True if the neighbour is walkable.
+         */
+        void AddEdge(int node, int neighbour, int direction, bool isWalkable);
+
+        /**
+         * @brief Removes every neighbour of a node, in both directions.
+         *
+         * @param node: Index of the node.
+         */
+        void RemoveEdges(int node);
+
+        /**
+         * @brief Moves a node among the walkable or non walkable neighbours
+         *        of each of its neighbours.
+         *
+         * @param node:       Index of the node.
+         * @param isWalkable: True if the node became walkable.
+         */
+        void SetWalkable(int node, bool isWalkable);
+
+        /**
+         * @return Number of walkable neighbours of a node (they are the first
+         *         ones of GetNeighbours).
+         */
+        int GetDegree(int node) const
+        {
+            return degrees[node];
+        }
+
+        /**
+         * @return Number of neighbours of a node, walkable or not.
+         */
+        int GetNbNeighbours(int node) const
+        {
+            return nbNeighbours[node];
+        }
+
+        /**
+         * @return Indexes of the neighbours of a node, the walkable ones
+         *         first.
+         */
+        const int *GetNeighbours(int node) const
+        {
+            return &neighbours[node * NAV_GRAPH_MAX_DEGREE];
+        }
+
+        /**
+         * @return Directions from a node to each of its neighbours (same
+         *         order as GetNeighbours).
+         */
+        const signed char *GetDirections(int node) const
+        {
+            return &directions[node * NAV_GRAPH_MAX_DEGREE];
+        }
+
+        /**
+         * @return Number of nodes.
+         */
+        int GetNbNodes() const;
+
+    private:
+        std::vector<int> neighbours;
+        std::vector<signed char> directions;
+        std::vector<unsigned char> nbNeighbours;
+        std::vector<unsigned char> degrees;
+
+        /**
+         * @brief Swaps two neighbour slots of a node.
+         */
+        void SwapSlots(int node, int first, int second);
+};
+
+/**
+ * @brief Returns the opposite of a direction (LEFT becomes RIGHT, vice versa.
+ *        UP becomes DOWN, vice versa).
+ */
+inline int GetOppositeDirection(int direction)
+{
+    return direction ^ 1;
+}
+
+#endif // NAVGRAPH_H
@@ -0,0 +1,128 @@
+/*
+ * Project: Tower Defense
+ * File: PackedPath.cpp
+ * Unit test file: TestPackedPath.cpp
+ *
+ * Brief: This class contains the directions of a path packed on 2 bits each
+ *        (4 directions per byte), and a view used to read the directions
+ *        left to walk. The packed path never changes once created, so units
+ *        can share it: a unit only keeps its position in the path.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "PackedPath.h"
+
+PackedPath::PackedPath(const std::vector<int> &directions)
+{
+    nbSteps = directions.size();
+    bytes.assign((nbSteps + 3) / 4, 0);
+
+    for(unsigned int i = 0; i < nbSteps; i++)
+    {
+        bytes[i / 4] |= (directions[i] & 3) << (2 * (i % 4));
+    }
+}
+
+unsigned int PackedPath::size() const { return nbSteps; }
+
+/*
+ * Returns a direction of the path.
+ */
+int PackedPath::operator[](unsigned int i) const
+{
+    return (bytes[i / 4] >> (2 * (i % 4))) & 3;
+}
+
+PathView::PathView()
+{
+    first = 0;
+}
+
+PathView::PathView(const std::shared_ptr<const PackedPath> &path,
+                   unsigned int first)
+{
+    this->path = path;
+    this->first = first;
+}
+
+/*
+ * Returns the number of directions in the view.
+ */
+unsigned int PathView::size() const
+{
+    if(path == nullptr || first >= path->size())
+    {
+        return 0;
+    }
+
+    return path->size() - first;
+}
+
+bool PathView::empty() const { return size() == 0; }
+
+/*
+ * Returns a direction of the view, with bounds check.
+ */
+int PathView::at(unsigned int i) const
+{
+    if(i >= size())
+    {
+        throw std::out_of_range("PathView::at");
+    }
+
+    return (*path)[first + i];
+}
+
+int PathView::operator[](unsigned int i) const { return (*path)[first + i]; }
+
+/*
+ * Checks if both views contain the same directions.
+ */
+bool PathView::operator==(const PathView &view) const
+{
+    if(size() != view.size())
+    {
+        return false;
+    }
+
+    for(unsigned int i = 0; i < size(); i++)
+    {
+        if((*this)[i] != view[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PathView::operator!=(const PathView &view) const
+{
+    return !(*this == view);
+}
+
+/*
+ * Copies the directions of the view in a vector.
+ */
+std::vector<int> PathView::ToVector() const
+{
+    std::vector<int> directions;
+
+    directions.reserve(size());
+
+    for(unsigned int i = 0; i < size(); i++)
+    {
+        directions.push_back((*this)[i]);
+    }
+
+    return directions;
+}
+
+/*
+ * Returns a view of the same path without its first directions.
+ */
+PathView PathView::Skip(unsigned int nbDirections) const
+{
+    return PathView(path, first + std::min(nbDirections, size()));
+}
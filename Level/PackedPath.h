@@ -0,0 +1,106 @@
+#ifndef PACKEDPATH_H
+#define PACKEDPATH_H
+
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Immutable list of directions (DIRECTION_LEFT to DIRECTION_DOWN)
+ *        packed on 2 bits each. A path is created once by a search, then
+ *        shared (never copied) by all the units following it.
+ */
+class PackedPath
+{
+    public:
+        /**
+         * @param directions: Directions of the path (only LEFT, RIGHT, UP
+         *                    and DOWN can be stored).
+         */
+        PackedPath(const std::vector<int> &directions);
+
+        /**
+         * @return Number of directions in the path.
+         */
+        unsigned int size() const;
+
+        /**
+         * @brief Returns a direction of the path (no bounds check).
+         *
+         * @param i: Position of the direction in the path.
+         */
+        int operator[](unsigned int i) const;
+
+    private:
+        std::vector<unsigned char> bytes;
+        unsigned int nbSteps;
+};
+
+/**
+ * @brief Read-only view of the directions of a shared PackedPath, starting at
+ *        a step of the path (the directions already walked are skipped).
+ *        Used like a vector of directions: size(), at() and [].
+ */
+class PathView
+{
+    public:
+        PathView();
+
+        /**
+         * @param path:  Shared path to look at (can be nullptr for an empty
+         *               view).
+         * @param first: First step of the path seen by the view.
+         */
+        PathView(const std::shared_ptr<const PackedPath> &path,
+                 unsigned int first);
+
+        /**
+         * @return Number of directions in the view.
+         */
+        unsigned int size() const;
+
+        /**
+         * @return True if the view has no direction.
+         */
+        bool empty() const;
+
+        /**
+         * @brief Returns a direction of the view.
+         *
+         * @param i: Position of the direction in the view.
+         *
+         * @throw std::out_of_range if i is not lower than size().
+         */
+        int at(unsigned int i) const;
+
+        /**
+         * @brief Returns a direction of the view (no bounds check).
+         *
+         * @param i: Position of the direction in the view.
+         */
+        int operator[](unsigned int i) const;
+
+        /**
+         * @return True if both views contain the same directions.
+         */
+        bool operator==(const PathView &view) const;
+        bool operator!=(const PathView &view) const;
+
+        /**
+         * @brief Copies the directions of the view in a vector.
+         */
+        std::vector<int> ToVector() const;
+
+        /**
+         * @return View of the same path without its first directions (empty
+         *         if there are not that many directions).
+         *
+         * @param nbDirections: Number of directions to skip.
+         */
+        PathView Skip(unsigned int nbDirections) const;
+
+    private:
+        std::shared_ptr<const PackedPath> path;
+        unsigned int first;
+};
+
+#endif // PACKEDPATH_H
@@ -15,60 +15,59 @@
  * This algorithm promises to find the shortest path every time and is rather
  * quickly executed.
  *
+ * The next cube to process is taken from an indexed binary heap (the open
+ * set) ordered by fCost, then hCost, then position of the cube in the vector,
+ * which gives the same tie-breaking as the previous linear search did.
+ * The walkable adjacent cubes are read from the navigation graph of the Grid
+ * (NavGraph.cpp), which is patched in place when walls change.
+ * The costs of the cubes are stored in a PathScratch instead of the cubes, so
+ * a search never modifies the grid and several searches can run on the same
+ * grid at the same time.
+ *
+ * Batches of searches (FindPaths) are spread over a thread pool, every
+ * thread searching with its own scratch.
+ *
+ * A hierarchical mode (FindPathHierarchical) uses HPA* (HierarchicalPath.cpp)
+ * for large grids.
+ *
+ * An incremental mode (FindPathIncremental) uses D* Lite (DStarLite.cpp) to
+ * repair the previous search when towers are placed or sold.
+ *
  * Benchmark tests:
  * Material: AMD Ryzen 5 1600X
  * Test case 1 => Non-obstructed 5 steps path (executed 100 000 times)
  * Result: ~45ms (0.045s)
- * Todo: make more benchmark tests
+ * Open and mazed grids from 10x10 to 500x500 are benchmarked in
+ * BenchPath.cpp (run the tests with the "[benchmark]" tag). The Catch
+ * benchmarks of FindPath and Unit::TestPath on open, mazed and blocked grids
+ * also write the nodes expanded per second in benchmark_pathfinding.csv.
  */
 
 #include <iostream>
 #include <cstdlib>
 #include <algorithm>
+#include <map>
+#include <tuple>
+#include <chrono>
 #include "Path.h"
-
-/**
- * @brief Returns a reference to the cube associated with the (x, y)
- *        coordinates.
- *
- * @param coordX: Coordinate in x of the cube to find.
- * @param coordY: Coordinate in y of the cube to find.
- * @param cubes:  Reference of cube vector.
- *
- * @return Pointer containing a reference to a cube or nullptr if no cube
- *         exist at the specified coordinates.
- */
-static Cube *FindCube(const int coordX, const int coordY,
-                      std::vector<Cube> &cubes);
-
-/**
- * @brief Returns a reference to the next cube to process.
- *
- * @param startingPointX: Coordinate of the point in X from where we find the
- *                        next cube to process.
- * @param startingPointY: Coordinate of the point in Y from where we find the
- *                        next cube to process.
- *
- * @return Pointer to the next cube with the lowest fCost and hCost.
- */
-static Cube *GetNextCube(const int startingPointX, const int startingPointY,
-                         std::vector<Cube> &cubes);
+#include "DStarLite.h"
+#include "ThreadPool.h"
+#include "HierarchicalPath.h"
 
 /**
  * @brief Propagates to the next adjacent cubes (gives the adjacent cubes a
- *        gCost, hCost and fCost).
+ *        gCost, hCost and fCost) and adds them to the open set.
  *
- * @param startingPointX: Coordinate in X where the path begins.
- * @param startingPointY: Coordinate in Y where the path begins.
- * @param endingPointX:   Coordinate in X where the path ends.
- * @param endingPointY:   Coordinate in Y where the path ends.
- * @param cube:           Cube to propagate from.
- * @param cubes:          Vector containing all the possible cubes to propagate
- *                        to.
+ * @param index:        Index of the cube to propagate from.
+ * @param endingPointX: Coordinate in X where the path ends.
+ * @param endingPointY: Coordinate in Y where the path ends.
+ * @param grid:         Grid containing all the possible cubes to propagate
+ *                      to.
+ * @param scratch:      Pathfinding attributes of the cubes for this search.
  */
-static void Propagate(const int startingPointX, const int startingPointY,
+static void Propagate(const int index,
                       const int endingPointX, const int endingPointY,
-                      Cube *cube, std::vector<Cube> &cubes);
+                      const Grid &grid, PathScratch &scratch);
 
 /**
  * @brief This function traces the path according to the child/parent relation
@@ -79,12 +78,14 @@ static void Propagate(const int startingPointX, const int startingPointY,
  * @param startingPointY: Coordinate in Y where the path begins.
  * @param endingPointX:   Coordinate in X where the path ends.
  * @param endingPointY:   Coordinate in Y where the path ends.
- * @param cubes:          Cube vector to get the path from.
+ * @param grid:           Grid to get the path from.
+ * @param scratch:        Pathfinding attributes of the cubes for this search.
  * @param directions:     The path. Vector where we store the directions.
  */
 static void CreatePath(const int startingPointX, const int startingPointY,
                        const int endingPointX, const int endingPointY,
-                       std::vector<Cube> &cubes, std::vector<int> &directions);
+                       const Grid &grid, const PathScratch &scratch,
+                       std::vector<int> &directions);
 
 /**
  * @brief Simple function to reverse the directions of a path.
@@ -92,82 +93,280 @@ static void CreatePath(const int startingPointX, const int startingPointY,
  */
 static void ReversePath(std::vector<int> &directions);
 
+Path::Path()
+{
+    step = 0;
+    stats = {0, 0, 0, 0, 0};
+}
+
+Path::~Path() = default;
+
+Path::Path(Path &&path) = default;
+
+Path &Path::operator=(Path &&path) = default;
+
+Path::Path(const Path &path)
+{
+    *this = path;
+}
+
 /*
- * Finds a path between a starting point and an ending point.
- * Returns true if path is found, false otherwise.
+ * Copies the directions of a path, without its incremental planner and its
+ * hierarchy.
+ */
+Path &Path::operator=(const Path &path)
+{
+    directions = path.directions;
+    step = path.step;
+    stats = path.stats;
+
+    return *this;
+}
+
+/*
+ * Finds a path between a starting point and an ending point in a vector of
+ * cubes. Returns true if path is found, false otherwise.
  */
 bool Path::FindPath(int startingPointX, int startingPointY,
                     int endingPointX, int endingPointY,
-                    std::vector<Cube> &cubes)
+                    const std::vector<Cube> &cubes)
+{
+    /* The search needs the coordinate index of a grid. */
+    Grid grid;
+    grid.SetCubes(cubes);
+
+    return FindPath(startingPointX, startingPointY,
+                    endingPointX, endingPointY, grid);
+}
+
+/*
+ * Finds a path between a starting point and an ending point in a grid, using
+ * the scratch of the calling thread.
+ */
+bool Path::FindPath(int startingPointX, int startingPointY,
+                    int endingPointX, int endingPointY, const Grid &grid)
+{
+    static thread_local PathScratch scratch;
+
+    return FindPath(startingPointX, startingPointY,
+                    endingPointX, endingPointY, grid, scratch);
+}
+
+/*
+ * Finds a path between a starting point and an ending point in a grid.
+ * Returns true if path is found, false otherwise.
+ */
+bool Path::FindPath(int startingPointX, int startingPointY,
+                    int endingPointX, int endingPointY, const Grid &grid,
+                    PathScratch &scratch)
 {
     bool isPathFound = false;
 
+    PATH_STATS_ONLY(auto begin = std::chrono::steady_clock::now());
+    PATH_STATS_ONLY(stats = {0, 0, 0, 0, 0});
+
     /* Make sure that we delete any preexisting path. */
     DeletePath();
 
-    Cube *cube;
-    cube = FindCube(startingPointX, startingPointY, cubes);
+    int index = grid.GetIndex(startingPointX, startingPointY);
 
     /* Check if the startingPoint is valid. */
-    if(cube == nullptr || cube->isWall)
+    if(index < 0 || grid.IsWall(index))
     {
         return false;
     }
-    else
-    {
-        cube->fCost = 0;
-    }
+
+    /*
+     * Forget the previous search (O(1)). The starting point is closed so
+     * that it is never propagated to.
+     */
+    scratch.Prepare(grid.cubes.size());
+    scratch.SetCosts(index, 0, 0, -1);
+    scratch.Close(index);
 
     for(;;)
     {
         /* We propagate values to the adjacent cubes. */
-        Propagate(startingPointX, startingPointY,
-                  endingPointX, endingPointY,
-                  cube, cubes);
+        Propagate(index, endingPointX, endingPointY, grid, scratch);
+        PATH_STATS_ONLY(stats.openSetPeak =
+                            std::max(stats.openSetPeak,
+                                     scratch.openSet.GetSize()));
 
-        /* Then we find the next cube to be the propagator. */
-        cube = GetNextCube(startingPointX, startingPointY, cubes);
+        /*
+         * Then the cube with the lowest fCost and hCost in the open set
+         * becomes the propagator.
+         */
+        index = scratch.openSet.Pop();
 
-        if(cube != nullptr)
+        /*
+         * When there is no remaining cubes to observe,
+         * the algorithm exits.
+         */
+        if(index < 0)
         {
-            cube->isVisited = true;
+            break;
         }
 
+        scratch.Close(index);
+
         /* Check if the ending point has been found. */
-        if(cube != nullptr &&
-           cube->coordX == endingPointX && cube->coordY == endingPointY &&
-           cube->isVisited)
+        if(grid.GetPosition(index).x == endingPointX
+           && grid.GetPosition(index).y == endingPointY)
         {
-            for(auto &i : cubes)
-            {
-                i.isVisited = false;
-            }
-
             /* If so, go ahead and create path.*/
+            static thread_local std::vector<int> newDirections;
+
+            newDirections.clear();
             CreatePath(startingPointX, startingPointY,
                        endingPointX, endingPointY,
-                       cubes, directions);
+                       grid, scratch, newDirections);
+            SetDirections(newDirections);
 
             isPathFound = true;
             break;
         }
-        /*
-         * When there is no remaining cubes to observe,
-         * the algorithm exits.
-         */
-        else if(cube == nullptr)
+    }
+
+#ifdef PATH_STATS
+    /* The starting point is given costs too. */
+    stats.nbSearches = 1;
+    stats.nbExpandedNodes = scratch.GetNbClosed();
+    stats.nbRelaxedNeighbours = scratch.GetNbCostsSet() - 1;
+    stats.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now() - begin).count();
+    PathFrameStats::Add(stats);
+#endif
+
+    return isPathFound;
+}
+
+/*
+ * Finds a path with the incremental planner (D* Lite), repairing the previous
+ * search when possible.
+ */
+bool Path::FindPathIncremental(int startingPointX, int startingPointY,
+                               int endingPointX, int endingPointY,
+                               const Grid &grid)
+{
+    if(planner == nullptr)
+    {
+        planner.reset(new DStarLite());
+    }
+
+    static thread_local std::vector<int> newDirections;
+    bool isPathFound = planner->FindPath(startingPointX, startingPointY,
+                                         endingPointX, endingPointY, grid,
+                                         newDirections);
+
+    SetDirections(newDirections);
+
+    return isPathFound;
+}
+
+/*
+ * Finds a path with the hierarchical mode (HPA*).
+ */
+bool Path::FindPathHierarchical(int startingPointX, int startingPointY,
+                                int endingPointX, int endingPointY,
+                                const Grid &grid)
+{
+    if(hierarchy == nullptr)
+    {
+        hierarchy.reset(new HierarchicalPath());
+    }
+
+    return FindPathHierarchical(startingPointX, startingPointY,
+                                endingPointX, endingPointY, grid, *hierarchy);
+}
+
+/*
+ * Finds a path with the hierarchical mode (HPA*) and the clusters given.
+ */
+bool Path::FindPathHierarchical(int startingPointX, int startingPointY,
+                                int endingPointX, int endingPointY,
+                                const Grid &grid, HierarchicalPath &hierarchy)
+{
+    static thread_local std::vector<int> newDirections;
+    bool isPathFound = hierarchy.FindPath(startingPointX, startingPointY,
+                                          endingPointX, endingPointY, grid,
+                                          newDirections);
+
+    SetDirections(newDirections);
+
+    return isPathFound;
+}
+
+/*
+ * Finds the paths of a batch of queries with the threads of a pool.
+ */
+int Path::FindPaths(const std::vector<PathQuery> &queries, const Grid &grid,
+                    std::vector<Path> &paths, ThreadPool &pool)
+{
+    int nbPathsFound = 0;
+    std::map<std::tuple<int, int, int, int>, int> firstQueries;
+    std::vector<int> uniqueQueries;
+    std::vector<int> sameQueries(queries.size());
+
+    paths.resize(queries.size());
+
+    /* Identical queries (units of a wave) are searched only once. */
+    for(unsigned int i = 0; i < queries.size(); i++)
+    {
+        auto key = std::make_tuple(queries[i].startingPointX,
+                                   queries[i].startingPointY,
+                                   queries[i].endingPointX,
+                                   queries[i].endingPointY);
+        auto first = firstQueries.emplace(key, i);
+
+        if(first.second)
         {
-            break;
+            uniqueQueries.push_back(i);
         }
+
+        sameQueries[i] = first.first->second;
     }
 
-    /* Reset cubes for future use. */
-    for(auto &i : cubes)
+    /*
+     * Each search writes only in its own path and uses the scratch of the
+     * thread running it, so no synchronisation is needed.
+     */
+    pool.Run(uniqueQueries.size(), [&queries, &grid, &paths,
+                                     &uniqueQueries](int i)
+    {
+        const PathQuery &query = queries[uniqueQueries[i]];
+
+        paths[uniqueQueries[i]].FindPath(query.startingPointX,
+                                         query.startingPointY,
+                                         query.endingPointX,
+                                         query.endingPointY, grid);
+    });
+
+    for(unsigned int i = 0; i < paths.size(); i++)
     {
-        i.ResetCosts();
+        /* Share the packed directions of the identical query. */
+        if(sameQueries[i] != static_cast<int>(i))
+        {
+            paths[i] = paths[sameQueries[i]];
+        }
+
+        if(paths[i].GetDirections().size() > 0)
+        {
+            nbPathsFound++;
+        }
     }
 
-    return isPathFound;
+    return nbPathsFound;
+}
+
+/*
+ * Finds the paths of a batch of queries with the shared thread pool.
+ */
+int Path::FindPaths(const std::vector<PathQuery> &queries, const Grid &grid,
+                    std::vector<Path> &paths)
+{
+    static ThreadPool pool;
+
+    return FindPaths(queries, grid, paths, pool);
 }
 
 /*
@@ -196,27 +395,27 @@ static void ReversePath(std::vector<int> &directions)
 }
 
 /*
- * Creates a path according to the cubes' states.
+ * Creates a path according to the parent directions found by the search.
  */
 static void CreatePath(const int startingPointX, const int startingPointY,
                        const int endingPointX, const int endingPointY,
-                       std::vector<Cube> &cubes, std::vector<int> &directions)
+                       const Grid &grid, const PathScratch &scratch,
+                       std::vector<int> &directions)
 {
-    Cube *cube = nullptr;
     int x = endingPointX;
     int y = endingPointY;
     int currentDirection = -1;
 
     while(x != startingPointX || y != startingPointY)
     {
-        cube = FindCube(x, y, cubes);
+        int index = grid.GetIndex(x, y);
 
-        if(cube == nullptr)
+        if(index < 0 || !scratch.IsSeen(index))
         {
             break;
         }
 
-        currentDirection = cube->shortestPathDir;
+        currentDirection = scratch.GetShortestPathDir(index);
 
         switch(currentDirection)
         {
@@ -250,138 +449,92 @@ static void CreatePath(const int startingPointX, const int startingPointY,
 }
 
 /*
- * Sets the gCost, hCost and fCost for adjacent cubes to the one in parameters.
+ * Sets the gCost, hCost and fCost for adjacent cubes to the one in parameters
+ * and adds them to the open set.
  */
-static void Propagate(const int startingPointX, const int startingPointY,
+static void Propagate(const int index,
                       const int endingPointX, const int endingPointY,
-                      Cube *cube, std::vector<Cube> &cubes)
+                      const Grid &grid, PathScratch &scratch)
 {
-    Cube *tempCube = nullptr;
-    int shortestPathDir = -1;
+    const NavGraph &navGraph = grid.GetNavGraph();
+    const int *neighbours = navGraph.GetNeighbours(index);
+    const signed char *directions = navGraph.GetDirections(index);
+    int gCost = scratch.GetGCost(index) + 1;
 
-    /* Propagate to all adjacent cubes. */
-    for(int i = 0, j = 0, k = 0; k < 4; k++)
+    /* Propagate to the walkable adjacent cubes (first in the graph). */
+    for(int k = 0; k < navGraph.GetDegree(index); k++)
     {
-        switch(k)
-        {
-        case 0: /* Propagate to left adjacent cube. */
-            i = -1, j = 0;
-            shortestPathDir = DIRECTION_RIGHT;
-            break;
-        case 1: /* Propagate to right adjacent cube. */
-            i = 1, j = 0;
-            shortestPathDir = DIRECTION_LEFT;
-            break;
-        case 2: /* Propagate to up adjacent cube. */
-            i = 0, j = -1;
-            shortestPathDir = DIRECTION_DOWN;
-            break;
-        case 3: /* Propagate to down adjacent cube. */
-            i = 0, j = 1;
-            shortestPathDir = DIRECTION_UP;
-            break;
-        }
-
-        /* Make sure that the current cube is not the starting point. */
-        if(cube->coordX + i != startingPointX
-           || cube->coordY + j != startingPointY)
-        {
-            tempCube = FindCube(cube->coordX + i, cube->coordY + j, cubes);
-        }
-        else
-        {
-            tempCube = nullptr;
-        }
+        int tempIndex = neighbours[k];
 
         /* Give gCost, hCost and fCost values for the current adjacent cube. */
-        if(tempCube != nullptr && !tempCube->isVisited && !tempCube->isWall)
+        if(!scratch.IsClosed(tempIndex)
+           && (!scratch.IsSeen(tempIndex)
+               || gCost < scratch.GetGCost(tempIndex)))
         {
-            int add = cube->gCost;
-
-            if(add < 0)
-            {
-                add = 0;
-            }
-
-            add++;
-
-            if(add < tempCube->gCost || tempCube->gCost < 0)
-            {
-                tempCube->gCost = add;
-                tempCube->hCost = abs(endingPointX - tempCube->coordX)
-                                  + abs(endingPointY - tempCube->coordY);
-                tempCube->fCost = tempCube->gCost + tempCube->hCost;
-                tempCube->shortestPathDir = shortestPathDir;
-            }
+            const Coordinates &position = grid.GetPosition(tempIndex);
+            int hCost = abs(endingPointX - position.x)
+                        + abs(endingPointY - position.y);
+
+            /* The adjacent cube points back towards the current cube. */
+            scratch.SetCosts(tempIndex, gCost, hCost,
+                             GetOppositeDirection(directions[k]));
+            scratch.openSet.Push(tempIndex,
+                                 {gCost + hCost, hCost, tempIndex});
         }
     }
 }
 
+PathView Path::GetDirections() const { return PathView(directions, step); }
+
+const PathStats &Path::GetStats() const { return stats; }
+
+std::shared_ptr<const PackedPath> Path::GetPackedPath() const
+{
+    return directions;
+}
+
 /*
- * Returns the next cube to process.
+ * Replaces the path by new directions.
  */
-static Cube *GetNextCube(const int startingPointX, const int startingPointY,
-                         std::vector<Cube> &cubes)
+void Path::SetDirections(const std::vector<int> &directions)
 {
-    Cube *tempCube = nullptr;
-    int lowestFCost = INT_MAX;
-    int lowestHCost = INT_MAX;
+    step = 0;
 
-    /* Find the lowest F cost. */
-    for(auto &i : cubes)
+    if(directions.empty())
     {
-        if(!i.isVisited && !i.isWall
-           && (i.coordX != startingPointX || i.coordY != startingPointY)
-           && i.fCost < lowestFCost)
-        {
-
-            if(i.fCost >= 0)
-            {
-                lowestFCost = i.fCost;
-            }
-        }
+        this->directions.reset();
     }
-
-    /*
-     * Find the cube with the lowest H cost between all the cubes that have an
-     * F cost equal to lowestFCost.
-     */
-    for(auto &i : cubes)
+    else
     {
-        if(!i.isVisited && !i.isWall && i.fCost == lowestFCost && i.hCost >= 0
-           && i.hCost < lowestHCost)
-        {
-            lowestHCost = i.hCost;
-            tempCube = &i;
-        }
+        this->directions = std::make_shared<const PackedPath>(directions);
     }
+}
 
-    return tempCube;
+/*
+ * Makes the path use a packed path already created.
+ */
+void Path::SetPackedPath(const std::shared_ptr<const PackedPath> &directions)
+{
+    this->directions = directions;
+    step = 0;
 }
 
 /*
- * Returns the reference to the cube associated with the (x, y) coordinates.
+ * Moves to the next direction of the path.
  */
-static Cube *FindCube(const int coordX, const int coordY,
-                      std::vector<Cube> &cubes)
+void Path::Advance()
 {
-    for(auto &i : cubes)
+    if(directions != nullptr && step < directions->size())
     {
-        if(i.coordX == coordX && i.coordY == coordY)
-        {
-            return &i;
-        }
+        step++;
     }
-
-    return nullptr;
 }
 
-std::vector<int> &Path::GetDirections() { return directions; }
-
 /*
  * Empties the path.
  */
 void Path::DeletePath()
 {
-    directions.clear();
+    directions.reset();
+    step = 0;
 }
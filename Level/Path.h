@@ -2,14 +2,31 @@
 #define PATH_H
 
 #include <vector>
-#include "Cube.h"
+#include <memory>
+#include "Grid.h"
+#include "PathScratch.h"
+#include "PackedPath.h"
+#include "PathStats.h"
+
+class DStarLite;
+class ThreadPool;
+class HierarchicalPath;
 
 /**
- * @brief Constants for all the possible directions in which an adjacent tile
- *        can be.
+ * @brief Starting point and ending point of a path to find in a batch (see
+ *        Path::FindPaths).
+ *
+ * @param startingPointX: Coordinate in X where the path begins.
+ * @param startingPointY: Coordinate in Y where the path begins.
+ * @param endingPointX:   Coordinate in X where the path ends.
+ * @param endingPointY:   Coordinate in Y where the path ends.
  */
-enum DIRECTION{DIRECTION_LEFT, DIRECTION_RIGHT, DIRECTION_UP, DIRECTION_DOWN,
-               DIRECTION_MIDDLE};
+typedef struct PathQuery{
+    int startingPointX;
+    int startingPointY;
+    int endingPointX;
+    int endingPointY;
+} PathQuery;
 
 /**
  * @brief This class gives you the method findPath to find a path between
@@ -18,15 +35,71 @@ enum DIRECTION{DIRECTION_LEFT, DIRECTION_RIGHT, DIRECTION_UP, DIRECTION_DOWN,
 class Path
 {
     public:
+        Path();
+        virtual ~Path();
+
+        /*
+         * A copy only gets the directions (the packed path is shared, so
+         * copies are cheap). The incremental planner and the hierarchy are
+         * modified by every search, so they are never shared nor copied: a
+         * copy builds its own on its first incremental or hierarchical
+         * search, and a path assigned to keeps its own.
+         */
+        Path(const Path &path);
+        Path &operator=(const Path &path);
+        Path(Path &&path);
+        Path &operator=(Path &&path);
+
+        /**
+         * @return The directions of the path left to walk (a view of the
+         *         shared packed path, cheap to get).
+         */
+        PathView GetDirections() const;
+
+        /**
+         * @brief Replaces the path by new directions, packed in a new buffer
+         *        (the buffer of the previous path is not modified, other
+         *        paths may still use it).
+         *
+         * @param directions: Directions of the new path.
+         */
+        void SetDirections(const std::vector<int> &directions);
+
+        /**
+         * @brief Makes the path use a packed path already created (shared,
+         *        not copied), starting at its first direction.
+         *
+         * @param directions: Packed directions (nullptr for an empty path).
+         */
+        void SetPackedPath(const std::shared_ptr<const PackedPath> &directions);
+
+        /**
+         * @return The packed directions of the whole path (including the
+         *         directions already walked), nullptr if the path is empty.
+         */
+        std::shared_ptr<const PackedPath> GetPackedPath() const;
+
+        /**
+         * @brief Returns the statistics of the last FindPath of this path
+         *        (nodes expanded, neighbours relaxed, open set peak and wall
+         *        time). The searches are also added to the statistics of the
+         *        frame (see PathFrameStats).
+         *
+         * @note Only counted when PATH_STATS is defined, every value is 0
+         *       otherwise.
+         */
+        const PathStats &GetStats() const;
+
         /**
-         * @return The vector containing the directions of the path.
+         * @brief Moves to the next direction of the path (the first direction
+         *        is walked), in O(1).
          */
-        std::vector<int> &GetDirections();
+        void Advance();
 
         /**
          * @brief When called, uses A* (A star) algorithm to find the shortest
          *        path from the starting point to the ending point and stores
-         *        the path in the directions vector.
+         *        the path in a new packed path.
          *
          * @param startingPointX: Coordinate in X where the path begins.
          * @param startingPointY: Coordinate in Y where the path begins.
@@ -41,14 +114,155 @@ class Path
          */
         bool FindPath(int startingPointX, int startingPointY,
                       int endingPointX, int endingPointY,
-                      std::vector<Cube> &cubes);
+                      const std::vector<Cube> &cubes);
+
+        /**
+         * @brief Same as above, but uses the coordinate index of a grid to
+         *        find the adjacent cubes (faster, the index is already
+         *        built).
+         *
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         * @param grid:           Grid of cubes to extract the path from.
+         *
+         * @return True if path is found, false otherwise.
+         *
+         * @note The grid is never modified, so several searches can run on
+         *       the same grid at the same time (each thread has its own
+         *       scratch).
+         */
+        bool FindPath(int startingPointX, int startingPointY,
+                      int endingPointX, int endingPointY, const Grid &grid);
+
         /**
-         * @brief Empties out the data in the directions vector.
+         * @brief Same as above, but with a scratch given by the caller to
+         *        store the costs of the cubes during the search.
+         *
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         * @param grid:           Grid of cubes to extract the path from.
+         * @param scratch:        Scratch used by the search (its content is
+         *                        overwritten).
+         *
+         * @return True if path is found, false otherwise.
+         */
+        bool FindPath(int startingPointX, int startingPointY,
+                      int endingPointX, int endingPointY, const Grid &grid,
+                      PathScratch &scratch);
+
+        /**
+         * @brief Incremental mode. Finds the shortest path like FindPath but
+         *        with the D* Lite algorithm, which keeps its search state
+         *        between calls. When the same destination is requested again,
+         *        only the part of the search affected by the walls that
+         *        changed in the grid (see Grid::SetWall) is repaired, and the
+         *        starting point may have moved since the previous call.
+         *
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         * @param grid:           Grid of cubes to extract the path from.
+         *
+         * @return True if path is found, false otherwise.
+         *
+         * @note The search state belongs to this Path: a copy starts over
+         *       with a full search (see the copy constructor).
+         */
+        bool FindPathIncremental(int startingPointX, int startingPointY,
+                                 int endingPointX, int endingPointY,
+                                 const Grid &grid);
+
+        /**
+         * @brief Hierarchical mode, for large grids. Finds a path like
+         *        FindPath but with HPA*: the search is done on the entrances
+         *        between clusters of cubes, then only inside of the clusters
+         *        used by the path. The clusters are kept between calls and
+         *        only the ones containing changed walls are computed again.
+         *
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         * @param grid:           Grid of cubes to extract the path from.
+         *
+         * @return True if path is found, false otherwise.
+         *
+         * @note The path may be a few steps longer than the one of FindPath.
+         *       The clusters belong to this Path: a copy computes its own
+         *       (use the overload below to share clusters between paths).
+         */
+        bool FindPathHierarchical(int startingPointX, int startingPointY,
+                                  int endingPointX, int endingPointY,
+                                  const Grid &grid);
+
+        /**
+         * @brief Same as above, but with clusters given by the caller (so
+         *        that every unit of a level can use the same clusters).
+         *
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         * @param grid:           Grid of cubes to extract the path from.
+         * @param hierarchy:      Clusters of the grid.
+         *
+         * @return True if path is found, false otherwise.
+         */
+        bool FindPathHierarchical(int startingPointX, int startingPointY,
+                                  int endingPointX, int endingPointY,
+                                  const Grid &grid,
+                                  HierarchicalPath &hierarchy);
+
+        /**
+         * @brief Finds the paths of many queries at once, spreading the
+         *        searches over the threads of a pool (each thread uses its own
+         *        scratch, the grid is only read). Every search is independent
+         *        and done with FindPath, so the paths are the same whatever
+         *        the number of threads. Identical queries are searched once
+         *        and their paths share the same packed directions.
+         *
+         * @param queries: Starting and ending points of the paths to find.
+         * @param grid:    Grid of cubes to extract the paths from (must not
+         *                 change during the call).
+         * @param paths:   Vector where the paths are stored, resized to the
+         *                 number of queries. paths[i] is the path of
+         *                 queries[i] (empty if no path was found).
+         * @param pool:    Threads used for the searches.
+         *
+         * @return The number of paths found.
+         */
+        static int FindPaths(const std::vector<PathQuery> &queries,
+                             const Grid &grid, std::vector<Path> &paths,
+                             ThreadPool &pool);
+
+        /**
+         * @brief Same as above, with a pool shared by the whole game (one
+         *        thread per hardware thread).
+         */
+        static int FindPaths(const std::vector<PathQuery> &queries,
+                             const Grid &grid, std::vector<Path> &paths);
+
+        /**
+         * @brief Empties out the path.
          */
         void DeletePath();
 
     private:
-        std::vector<int> directions;
+        /*
+         * Directions of the path, shared between the copies of the path
+         * (never modified once created), and position of the next direction
+         * to walk.
+         */
+        std::shared_ptr<const PackedPath> directions;
+        unsigned int step;
+        PathStats stats;
+        std::unique_ptr<DStarLite> planner;
+        std::unique_ptr<HierarchicalPath> hierarchy;
 };
 
 #endif // PATH_H
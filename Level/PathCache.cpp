@@ -0,0 +1,156 @@
+/*
+ * Project: Tower Defense
+ * File: PathCache.cpp
+ * Unit test file: TestPathCache.cpp
+ *
+ * Brief: This class remembers the paths found between two points. The units
+ *        of a wave all ask for the same path, and the placement checks ask
+ *        the same question many times while the map does not change. The
+ *        paths are kept for one version of the grid (incremented every time
+ *        a wall or a tower is placed or removed), so a cached path is always
+ *        the one a search would find. Hits and misses are counted to see how
+ *        effective the cache is.
+ */
+
+#include "PathCache.h"
+
+/* Number of paths after which the cache is emptied, to bound its memory. */
+#define MAX_CACHED_PATHS 4096
+
+PathCache::PathCache()
+{
+    gridVersion = 0;
+    nbHits = 0;
+    nbMisses = 0;
+}
+
+/*
+ * Gives to a path the directions between two points, searching only if they
+ * are not already known.
+ */
+bool PathCache::FindPath(int startingPointX, int startingPointY,
+                         int endingPointX, int endingPointY, const Grid &grid,
+                         Path &path)
+{
+    if(Lookup(startingPointX, startingPointY, endingPointX, endingPointY,
+              grid, path))
+    {
+        return !path.GetDirections().empty();
+    }
+
+    bool isFound = path.FindPath(startingPointX, startingPointY,
+                                 endingPointX, endingPointY, grid);
+
+    Store(startingPointX, startingPointY, endingPointX, endingPointY, grid,
+          path);
+
+    return isFound;
+}
+
+/*
+ * Checks if a path exists between two points.
+ */
+bool PathCache::TestPath(int startingPointX, int startingPointY,
+                         int endingPointX, int endingPointY, const Grid &grid)
+{
+    CheckVersion(grid);
+
+    auto it = paths.find({startingPointX, startingPointY,
+                          endingPointX, endingPointY});
+
+    if(it != paths.end())
+    {
+        nbHits++;
+        return it->second != nullptr;
+    }
+
+    nbMisses++;
+
+    return reachability.IsReachable(grid, startingPointX, startingPointY,
+                                    endingPointX, endingPointY);
+}
+
+/*
+ * Looks for a path in the cache only.
+ */
+bool PathCache::Lookup(int startingPointX, int startingPointY,
+                       int endingPointX, int endingPointY, const Grid &grid,
+                       Path &path)
+{
+    CheckVersion(grid);
+
+    auto it = paths.find({startingPointX, startingPointY,
+                          endingPointX, endingPointY});
+
+    if(it == paths.end())
+    {
+        nbMisses++;
+        return false;
+    }
+
+    nbHits++;
+    path.SetPackedPath(it->second);
+
+    return true;
+}
+
+/*
+ * Adds to the cache a path found on the current version of the grid.
+ */
+void PathCache::Store(int startingPointX, int startingPointY,
+                      int endingPointX, int endingPointY, const Grid &grid,
+                      const Path &path)
+{
+    CheckVersion(grid);
+
+    if(paths.size() >= MAX_CACHED_PATHS)
+    {
+        paths.clear();
+    }
+
+    std::shared_ptr<const PackedPath> directions = path.GetPackedPath();
+
+    /* An empty path means that there is no path. */
+    if(directions != nullptr && directions->size() == 0)
+    {
+        directions = nullptr;
+    }
+
+    paths[{startingPointX, startingPointY, endingPointX, endingPointY}] =
+        directions;
+}
+
+/*
+ * Forgets every path.
+ */
+void PathCache::Clear()
+{
+    paths.clear();
+}
+
+/*
+ * Resets the hit and miss counters.
+ */
+void PathCache::ResetCounters()
+{
+    nbHits = 0;
+    nbMisses = 0;
+}
+
+/*
+ * Forgets every path if the grid changed since they were found.
+ */
+void PathCache::CheckVersion(const Grid &grid)
+{
+    if(grid.GetVersion() != gridVersion)
+    {
+        paths.clear();
+        gridVersion = grid.GetVersion();
+    }
+}
+
+unsigned long PathCache::GetNbHits() const { return nbHits; }
+
+unsigned long PathCache::GetNbMisses() const { return nbMisses; }
+
+unsigned int PathCache::GetNbPaths() const { return paths.size(); }
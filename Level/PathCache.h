@@ -0,0 +1,140 @@
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include <unordered_map>
+#include <memory>
+#include "Grid.h"
+#include "Path.h"
+#include "Reachability.h"
+
+/**
+ * @brief This class remembers the paths found between two points for the
+ *        current version of a grid. Asking again for the same path while the
+ *        grid did not change (no wall or tower placed) is a hash table lookup
+ *        and the units get the same shared packed path. All the paths are
+ *        forgotten as soon as the grid version changes.
+ *
+ * @note A cache must always be used with the same grid and is not thread
+ *       safe.
+ */
+class PathCache
+{
+    public:
+        PathCache();
+
+        /**
+         * @brief Gives to a path the directions from a starting point to an
+         *        ending point: from the cache if they are known for the
+         *        current version of the grid, otherwise with a search
+         *        (Path::FindPath) whose result is added to the cache.
+         *
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         * @param grid:           Grid of cubes to extract the path from.
+         * @param path:           Path receiving the directions.
+         *
+         * @return True if path is found, false otherwise.
+         */
+        bool FindPath(int startingPointX, int startingPointY,
+                      int endingPointX, int endingPointY, const Grid &grid,
+                      Path &path);
+
+        /**
+         * @brief Checks if a path exists between two points. Answered by the
+         *        cache when the path is known, otherwise with a flood fill
+         *        (see Reachability) which is not added to the cache.
+         *
+         * @return True if a path exists, false otherwise.
+         */
+        bool TestPath(int startingPointX, int startingPointY,
+                      int endingPointX, int endingPointY, const Grid &grid);
+
+        /**
+         * @brief Looks for a path in the cache only.
+         *
+         * @param path: Path receiving the directions if they are known.
+         *
+         * @return True if the path is known for the current version of the
+         *         grid (found or not), false otherwise.
+         */
+        bool Lookup(int startingPointX, int startingPointY,
+                    int endingPointX, int endingPointY, const Grid &grid,
+                    Path &path);
+
+        /**
+         * @brief Adds to the cache a path found elsewhere (for example by
+         *        Path::FindPaths) on the current version of the grid.
+         *
+         * @param path: Path found (empty if there is no path).
+         */
+        void Store(int startingPointX, int startingPointY,
+                   int endingPointX, int endingPointY, const Grid &grid,
+                   const Path &path);
+
+        /**
+         * @brief Forgets every path (the counters are kept).
+         */
+        void Clear();
+
+        /**
+         * @brief Resets the hit and miss counters.
+         */
+        void ResetCounters();
+
+        /* Getters. */
+        unsigned long GetNbHits() const;
+        unsigned long GetNbMisses() const;
+        unsigned int GetNbPaths() const;
+
+    private:
+        /**
+         * @brief Starting and ending points of a path.
+         */
+        typedef struct PathKey{
+            int startingPointX;
+            int startingPointY;
+            int endingPointX;
+            int endingPointY;
+
+            bool operator==(const PathKey &key) const
+            {
+                return startingPointX == key.startingPointX
+                       && startingPointY == key.startingPointY
+                       && endingPointX == key.endingPointX
+                       && endingPointY == key.endingPointY;
+            }
+        } PathKey;
+
+        /**
+         * @brief Hash function of the keys.
+         */
+        typedef struct PathKeyHash{
+            size_t operator()(const PathKey &key) const
+            {
+                size_t hash = key.startingPointX;
+
+                hash = hash * 31 + key.startingPointY;
+                hash = hash * 31 + key.endingPointX;
+                hash = hash * 31 + key.endingPointY;
+
+                return std::hash<size_t>()(hash);
+            }
+        } PathKeyHash;
+
+        /* Packed directions of the path, nullptr if there is no path. */
+        std::unordered_map<PathKey, std::shared_ptr<const PackedPath>,
+                           PathKeyHash> paths;
+        Reachability reachability;
+        unsigned int gridVersion;
+        unsigned long nbHits;
+        unsigned long nbMisses;
+
+        /**
+         * @brief Forgets every path if the grid changed.
+         */
+        void CheckVersion(const Grid &grid);
+};
+
+#endif // PATHCACHE_H
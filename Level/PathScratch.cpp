@@ -0,0 +1,94 @@
+/*
+ * Project: Tower Defense
+ * File: PathScratch.cpp
+ *
+ * Brief: This class contains the pathfinding attributes of the cubes for one
+ *        search. Every value is stamped with the generation of the search
+ *        that wrote it, which makes resetting the scratch between two
+ *        searches O(1).
+ */
+
+#include "PathScratch.h"
+#include "PathStats.h"
+
+PathScratch::PathScratch()
+{
+    generation = 0;
+    nbClosed = 0;
+    nbCostsSet = 0;
+}
+
+/*
+ * Prepares the scratch for a new search.
+ */
+void PathScratch::Prepare(int nbCubes)
+{
+    if(static_cast<int>(seenStamps.size()) != nbCubes)
+    {
+        gCosts.assign(nbCubes, -1);
+        hCosts.assign(nbCubes, -1);
+        shortestPathDirs.assign(nbCubes, -1);
+        seenStamps.assign(nbCubes, 0);
+        closedStamps.assign(nbCubes, 0);
+        generation = 0;
+    }
+
+    generation++;
+    nbClosed = 0;
+    nbCostsSet = 0;
+
+    /* Stamps from 2^32 searches ago would look valid, reset them. */
+    if(generation == 0)
+    {
+        seenStamps.assign(nbCubes, 0);
+        closedStamps.assign(nbCubes, 0);
+        generation = 1;
+    }
+
+    openSet.Reset(nbCubes);
+}
+
+/*
+ * Sets the pathfinding attributes of a cube for this search.
+ */
+void PathScratch::SetCosts(int index, int gCost, int hCost,
+                           int shortestPathDir)
+{
+    gCosts[index] = gCost;
+    hCosts[index] = hCost;
+    shortestPathDirs[index] = shortestPathDir;
+    seenStamps[index] = generation;
+    PATH_STATS_ONLY(nbCostsSet++);
+}
+
+/*
+ * Marks a cube as visited for this search.
+ */
+void PathScratch::Close(int index)
+{
+    closedStamps[index] = generation;
+    nbClosed++;
+}
+
+bool PathScratch::IsSeen(int index) const
+{
+    return seenStamps[index] == generation;
+}
+
+bool PathScratch::IsClosed(int index) const
+{
+    return closedStamps[index] == generation;
+}
+
+int PathScratch::GetGCost(int index) const { return gCosts[index]; }
+
+int PathScratch::GetHCost(int index) const { return hCosts[index]; }
+
+int PathScratch::GetShortestPathDir(int index) const
+{
+    return shortestPathDirs[index];
+}
+
+int PathScratch::GetNbClosed() const { return nbClosed; }
+
+int PathScratch::GetNbCostsSet() const { return nbCostsSet; }
@@ -0,0 +1,112 @@
+#ifndef PATHSCRATCH_H
+#define PATHSCRATCH_H
+
+#include <vector>
+#include "../Template Helpers/TIndexedHeap.h"
+
+/**
+ * @brief Key of a cube in the open set. Cubes are ordered by fCost, then by
+ *        hCost and finally by their index in the cube vector.
+ *
+ * @param fCost: fCost of the cube.
+ * @param hCost: hCost of the cube.
+ * @param index: Index of the cube in the cube vector.
+ */
+typedef struct OpenSetKey{
+    int fCost;
+    int hCost;
+    int index;
+
+    bool operator<(const OpenSetKey &key) const
+    {
+        if(fCost != key.fCost)
+        {
+            return fCost < key.fCost;
+        }
+        else if(hCost != key.hCost)
+        {
+            return hCost < key.hCost;
+        }
+
+        return index < key.index;
+    }
+} OpenSetKey;
+
+/**
+ * @brief This class contains the pathfinding attributes of the cubes for one
+ *        search (costs, parent direction, visited state and open set), so
+ *        that searches never write into the cubes. Values are stamped with
+ *        the generation of the search that wrote them: starting a new search
+ *        only increments the generation (O(1)) instead of resetting every
+ *        cube. A scratch must not be used by two searches at the same time.
+ */
+class PathScratch
+{
+    public:
+        IndexedHeap<OpenSetKey> openSet;
+
+        PathScratch();
+
+        /**
+         * @brief Prepares the scratch for a new search, invalidating the
+         *        values of the previous search.
+         *
+         * @param nbCubes: Number of cubes in the searched grid.
+         */
+        void Prepare(int nbCubes);
+
+        /**
+         * @brief Sets the pathfinding attributes of a cube for this search.
+         *
+         * @param index:           Index of the cube.
+         * @param gCost:           Distance from the starting point.
+         * @param hCost:           Estimated distance to the ending point.
+         * @param shortestPathDir: Direction towards the parent cube.
+         */
+        void SetCosts(int index, int gCost, int hCost, int shortestPathDir);
+
+        /**
+         * @brief Marks a cube as visited (closed) for this search.
+         *
+         * @param index: Index of the cube.
+         */
+        void Close(int index);
+
+        /**
+         * @return True if the cube was given costs during this search.
+         */
+        bool IsSeen(int index) const;
+
+        /**
+         * @return True if the cube was visited during this search.
+         */
+        bool IsClosed(int index) const;
+
+        /* Getters (only valid if IsSeen(index) is true). */
+        int GetGCost(int index) const;
+        int GetHCost(int index) const;
+        int GetShortestPathDir(int index) const;
+
+        /**
+         * @return Number of cubes visited (expanded) by the current search.
+         */
+        int GetNbClosed() const;
+
+        /**
+         * @return Number of times cubes were given costs by the current
+         *         search (only counted when PATH_STATS is defined).
+         */
+        int GetNbCostsSet() const;
+
+    private:
+        std::vector<int> gCosts;
+        std::vector<int> hCosts;
+        std::vector<signed char> shortestPathDirs;
+        std::vector<unsigned int> seenStamps;
+        std::vector<unsigned int> closedStamps;
+        unsigned int generation;
+        int nbClosed;
+        int nbCostsSet;
+};
+
+#endif // PATHSCRATCH_H
@@ -0,0 +1,75 @@
+/*
+ * Project: Tower Defense
+ * File: PathStats.cpp
+ * Unit test file: TestPath.cpp
+ *
+ * Brief: This class aggregates the statistics of the searches (see
+ *        Path::GetStats) per frame, to find out why a frame took too long.
+ *        The counters are atomics since searches run on the thread pool.
+ */
+
+#include <atomic>
+#include <mutex>
+#include "PathStats.h"
+
+/* Counters of the current frame. */
+static std::atomic<long> nbSearches(0);
+static std::atomic<long> nbExpandedNodes(0);
+static std::atomic<long> nbRelaxedNeighbours(0);
+static std::atomic<int> openSetPeak(0);
+static std::atomic<long long> totalTime(0);
+
+/* Statistics of the last complete frame. */
+static PathStats lastFrame = {0, 0, 0, 0, 0};
+static std::mutex lastFrameMutex;
+
+/*
+ * Adds the statistics of a search to the current frame.
+ */
+void PathFrameStats::Add(const PathStats &stats)
+{
+    nbSearches += stats.nbSearches;
+    nbExpandedNodes += stats.nbExpandedNodes;
+    nbRelaxedNeighbours += stats.nbRelaxedNeighbours;
+    totalTime += stats.time;
+
+    int peak = openSetPeak;
+
+    while(stats.openSetPeak > peak
+          && !openSetPeak.compare_exchange_weak(peak, stats.openSetPeak))
+    {
+    }
+}
+
+/*
+ * Ends the current frame and starts a new one.
+ */
+void PathFrameStats::EndFrame()
+{
+    std::lock_guard<std::mutex> lock(lastFrameMutex);
+
+    lastFrame.nbSearches = nbSearches.exchange(0);
+    lastFrame.nbExpandedNodes = nbExpandedNodes.exchange(0);
+    lastFrame.nbRelaxedNeighbours = nbRelaxedNeighbours.exchange(0);
+    lastFrame.openSetPeak = openSetPeak.exchange(0);
+    lastFrame.time = totalTime.exchange(0);
+}
+
+/*
+ * Returns the statistics of the last complete frame.
+ */
+PathStats PathFrameStats::GetLastFrame()
+{
+    std::lock_guard<std::mutex> lock(lastFrameMutex);
+
+    return lastFrame;
+}
+
+/*
+ * Returns the statistics of the current frame so far.
+ */
+PathStats PathFrameStats::GetCurrentFrame()
+{
+    return {nbSearches, nbExpandedNodes, nbRelaxedNeighbours, openSetPeak,
+            totalTime};
+}
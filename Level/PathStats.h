@@ -0,0 +1,66 @@
+#ifndef PATHSTATS_H
+#define PATHSTATS_H
+
+/*
+ * The statistics of the searches are only counted when PATH_STATS is defined
+ * (-DPATH_STATS). Otherwise the counting code is compiled out and every value
+ * stays at 0.
+ */
+#ifdef PATH_STATS
+#define PATH_STATS_ONLY(...) __VA_ARGS__
+#else
+#define PATH_STATS_ONLY(...)
+#endif
+
+/**
+ * @brief Statistics of one search, or of all the searches of a frame.
+ *
+ * @param nbSearches:          Number of searches.
+ * @param nbExpandedNodes:     Number of cubes visited (taken out of the open
+ *                             set).
+ * @param nbRelaxedNeighbours: Number of adjacent cubes given better costs.
+ * @param openSetPeak:         Largest size reached by the open set (the
+ *                             largest of all the searches for a frame).
+ * @param time:                Wall time spent searching, in nanoseconds.
+ */
+typedef struct PathStats{
+    long nbSearches;
+    long nbExpandedNodes;
+    long nbRelaxedNeighbours;
+    int openSetPeak;
+    long long time;
+} PathStats;
+
+/**
+ * @brief Aggregates the statistics of the searches per frame. Searches from
+ *        any thread can be added. The game calls EndFrame once per frame and
+ *        a debug overlay reads the statistics of the last complete frame.
+ */
+class PathFrameStats
+{
+    public:
+        /**
+         * @brief Adds the statistics of a search to the current frame.
+         *
+         * @param stats: Statistics of the search.
+         */
+        static void Add(const PathStats &stats);
+
+        /**
+         * @brief Ends the current frame: its statistics become the ones of
+         *        the last frame and a new frame is started.
+         */
+        static void EndFrame();
+
+        /**
+         * @return Statistics of the last complete frame.
+         */
+        static PathStats GetLastFrame();
+
+        /**
+         * @return Statistics of the current frame so far.
+         */
+        static PathStats GetCurrentFrame();
+};
+
+#endif // PATHSTATS_H
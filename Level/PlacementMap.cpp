@@ -0,0 +1,235 @@
+/*
+ * Project: Tower Defense
+ * File: PlacementMap.cpp
+ * Unit test file: TestPlacementMap.cpp
+ *
+ * Brief: This class computes which cubes would cut the path between the spawn
+ *        point and the destination if a tower was placed on them. Those cubes
+ *        are the articulation points of the walkable cubes that separate the
+ *        spawn point from the destination (plus the two points themselves).
+ *        A single depth-first search from the spawn point gives, for every
+ *        cube, its discovery time and the lowest discovery time reachable
+ *        from its subtree (Tarjan). Only the ancestors of the destination in
+ *        the search tree can separate it from the spawn point: an ancestor
+ *        does when the subtree leading to the destination cannot reach above
+ *        it without going through it. With several destinations, a cube
+ *        blocks the path when it separates the spawn point from all of the
+ *        reachable destinations.
+ */
+
+#include <algorithm>
+#include "PlacementMap.h"
+
+/**
+ * @brief Returns the index of the cube adjacent to another cube (0: left,
+ *        1: right, 2: up, 3: down), -1 if there is none.
+ */
+static int GetNeighbour(const Grid &grid, int index, int direction)
+{
+    const Coordinates &position = grid.GetPosition(index);
+
+    switch(direction)
+    {
+    case 0:
+        return grid.GetIndex(position.x - 1, position.y);
+    case 1:
+        return grid.GetIndex(position.x + 1, position.y);
+    case 2:
+        return grid.GetIndex(position.x, position.y - 1);
+    case 3:
+        return grid.GetIndex(position.x, position.y + 1);
+    }
+
+    return -1;
+}
+
+PlacementMap::PlacementMap()
+{
+    isPathBlocked = true;
+    gridVersion = 0;
+    spawnX = 0;
+    spawnY = 0;
+    isBuilt = false;
+}
+
+/*
+ * Computes, for every cube, if a wall on it would cut the path between the
+ * spawn point and the destination.
+ */
+void PlacementMap::Build(const Grid &grid, int spawnX, int spawnY,
+                         int destinationX, int destinationY)
+{
+    Build(grid, spawnX, spawnY,
+          std::vector<Coordinates>(1, {destinationX, destinationY}));
+}
+
+/*
+ * Computes, for every cube, if a wall on it would cut the path between the
+ * spawn point and all the destinations.
+ */
+void PlacementMap::Build(const Grid &grid, int spawnX, int spawnY,
+                         const std::vector<Coordinates> &destinations)
+{
+    int nbCubes = grid.cubes.size();
+    int spawn = grid.GetIndex(spawnX, spawnY);
+
+    this->spawnX = spawnX;
+    this->spawnY = spawnY;
+    this->destinations = destinations;
+    gridVersion = grid.GetVersion();
+    isBuilt = true;
+    isBlocking.assign(nbCubes, false);
+    isPathBlocked = true;
+
+    if(spawn < 0 || grid.IsWall(spawn))
+    {
+        return;
+    }
+
+    std::vector<int> discovery(nbCubes, -1);
+    std::vector<int> low(nbCubes, -1);
+    std::vector<int> parent(nbCubes, -1);
+    std::vector<signed char> nextDirection(nbCubes, 0);
+    std::vector<int> stack;
+    int time = 0;
+
+    /* Iterative depth-first search from the spawn point. */
+    discovery[spawn] = low[spawn] = time++;
+    stack.push_back(spawn);
+
+    while(!stack.empty())
+    {
+        int index = stack.back();
+
+        if(nextDirection[index] < 4)
+        {
+            int neighbour = GetNeighbour(grid, index, nextDirection[index]++);
+
+            if(neighbour < 0 || grid.IsWall(neighbour))
+            {
+                continue;
+            }
+
+            if(discovery[neighbour] < 0)
+            {
+                parent[neighbour] = index;
+                discovery[neighbour] = low[neighbour] = time++;
+                stack.push_back(neighbour);
+            }
+            else if(neighbour != parent[index])
+            {
+                low[index] = std::min(low[index], discovery[neighbour]);
+            }
+        }
+        else
+        {
+            stack.pop_back();
+
+            if(parent[index] >= 0)
+            {
+                low[parent[index]] = std::min(low[parent[index]], low[index]);
+            }
+        }
+    }
+
+    /* Number of reachable destinations separated by each cube. */
+    std::vector<int> nbSeparated(nbCubes, 0);
+    std::vector<bool> isDestination(nbCubes, false);
+    int nbReachable = 0;
+
+    for(auto const &i : destinations)
+    {
+        int destination = grid.GetIndex(i.x, i.y);
+
+        if(destination < 0 || destination == spawn
+           || discovery[destination] < 0 || isDestination[destination])
+        {
+            continue;
+        }
+
+        isDestination[destination] = true;
+        nbReachable++;
+        nbSeparated[destination]++;
+
+        /* Walk up the search tree from the destination to the spawn point. */
+        for(int child = destination, index = parent[destination];
+            index != spawn; child = index, index = parent[index])
+        {
+            if(low[child] >= discovery[index])
+            {
+                nbSeparated[index]++;
+            }
+        }
+    }
+
+    if(nbReachable == 0)
+    {
+        return;
+    }
+
+    isPathBlocked = false;
+    isBlocking[spawn] = true;
+
+    for(int i = 0; i < nbCubes; i++)
+    {
+        if(nbSeparated[i] == nbReachable)
+        {
+            isBlocking[i] = true;
+        }
+    }
+}
+
+/*
+ * Checks if the map is up to date.
+ */
+bool PlacementMap::IsUpToDate(const Grid &grid, int spawnX, int spawnY,
+                              int destinationX, int destinationY) const
+{
+    return isBuilt && gridVersion == grid.GetVersion()
+           && this->spawnX == spawnX && this->spawnY == spawnY
+           && destinations.size() == 1
+           && destinations[0].x == destinationX
+           && destinations[0].y == destinationY;
+}
+
+/*
+ * Checks if the map is up to date for these destinations.
+ */
+bool PlacementMap::IsUpToDate(const Grid &grid, int spawnX, int spawnY,
+                              const std::vector<Coordinates> &destinations)
+                              const
+{
+    if(!isBuilt || gridVersion != grid.GetVersion() || this->spawnX != spawnX
+       || this->spawnY != spawnY
+       || this->destinations.size() != destinations.size())
+    {
+        return false;
+    }
+
+    for(unsigned int i = 0; i < destinations.size(); i++)
+    {
+        if(this->destinations[i].x != destinations[i].x
+           || this->destinations[i].y != destinations[i].y)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Checks if placing a wall on a cube would block the path.
+ */
+bool PlacementMap::IsBlocking(const Grid &grid, int x, int y) const
+{
+    int index = grid.GetIndex(x, y);
+
+    if(index < 0 || grid.cubes[index].IsWall()
+       || index >= static_cast<int>(isBlocking.size()))
+    {
+        return false;
+    }
+
+    return isPathBlocked || isBlocking[index];
+}
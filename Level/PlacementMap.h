@@ -0,0 +1,87 @@
+#ifndef PLACEMENTMAP_H
+#define PLACEMENTMAP_H
+
+#include <vector>
+#include "Grid.h"
+
+/**
+ * @brief This class tells, for every cube of a grid, if placing a tower (a
+ *        wall) on it would leave no path between a spawn point and the
+ *        destinations. The whole map is computed at once (articulation points
+ *        of the walkable cubes) and only needs to be rebuilt when the grid
+ *        changes, so checking the cube under the mouse is a simple read.
+ */
+class PlacementMap
+{
+    public:
+        PlacementMap();
+
+        /**
+         * @brief Computes, for every cube, if a wall on it would cut the
+         *        path between the spawn point and the destination.
+         *
+         * @param grid:         Grid of cubes to compute the map on.
+         * @param spawnX:       Coordinate in x of the spawn point.
+         * @param spawnY:       Coordinate in y of the spawn point.
+         * @param destinationX: Coordinate in x of the destination.
+         * @param destinationY: Coordinate in y of the destination.
+         */
+        void Build(const Grid &grid, int spawnX, int spawnY,
+                   int destinationX, int destinationY);
+
+        /**
+         * @brief Same as above, but with several destinations: a wall blocks
+         *        the path when the spawn point could reach none of them
+         *        anymore (the units go to any destination).
+         *
+         * @param grid:         Grid of cubes to compute the map on.
+         * @param spawnX:       Coordinate in x of the spawn point.
+         * @param spawnY:       Coordinate in y of the spawn point.
+         * @param destinations: Coordinates of the destinations (the ones
+         *                      that do not exist or are walls are ignored).
+         */
+        void Build(const Grid &grid, int spawnX, int spawnY,
+                   const std::vector<Coordinates> &destinations);
+
+        /**
+         * @brief Checks if the map was built for these points and for the
+         *        current version of the grid.
+         *
+         * @return True if the map does not need to be rebuilt.
+         */
+        bool IsUpToDate(const Grid &grid, int spawnX, int spawnY,
+                        int destinationX, int destinationY) const;
+
+        /**
+         * @brief Same as above, with several destinations (in the same order
+         *        as when the map was built).
+         */
+        bool IsUpToDate(const Grid &grid, int spawnX, int spawnY,
+                        const std::vector<Coordinates> &destinations) const;
+
+        /**
+         * @brief Checks if placing a wall on a cube would leave no path from
+         *        the spawn point to a destination (same answer as calling
+         *        Unit::TestPath after placing the wall).
+         *
+         * @param grid: Grid the map was built on.
+         * @param x:    Coordinate of the cube in x.
+         * @param y:    Coordinate of the cube in y.
+         *
+         * @return True if the wall would block the path. Always true when
+         *         there is no path already, false for walls and for cubes
+         *         that do not exist (the path would not change).
+         */
+        bool IsBlocking(const Grid &grid, int x, int y) const;
+
+    private:
+        std::vector<bool> isBlocking;
+        bool isPathBlocked;
+        unsigned int gridVersion;
+        int spawnX;
+        int spawnY;
+        std::vector<Coordinates> destinations;
+        bool isBuilt;
+};
+
+#endif // PLACEMENTMAP_H
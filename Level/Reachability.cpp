@@ -0,0 +1,408 @@
+/*
+ * Project: Tower Defense
+ * File: Reachability.cpp
+ * Unit test file: TestReachability.cpp
+ *
+ * Brief: This class implements reachability checks with bitsets. Every row of
+ *        the grid is packed in 64-bit words (bit set = walkable cube) and the
+ *        flood fill works on whole words:
+ *        - In a row, the reached cubes are spread left and right with an
+ *          occluded fill (Kogge-Stone), 6 shifts per word instead of one step
+ *          per cube.
+ *        - Between rows, reached = reached | (row above & walkable), which is
+ *          done on 4 words at once with AVX2 when it is available.
+ *        A row that gets new cubes is queued to spread them to the rows
+ *        above and below, until no row changes. Only the words of a row that
+ *        changed are spread and filled again, so a flood costs about one
+ *        pass over the words that contain reachable cubes.
+ */
+
+#include "Reachability.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Spreads bits toward the higher bits (to the right) without crossing
+ *        the zeros of a mask.
+ *
+ * @param gen: Bits to spread (must be inside the mask).
+ * @param pro: Mask of the bits that can be reached.
+ *
+ * @return The spread bits.
+ */
+static inline uint64_t FillRight(uint64_t gen, uint64_t pro)
+{
+    gen |= pro & (gen << 1);
+    pro &= pro << 1;
+    gen |= pro & (gen << 2);
+    pro &= pro << 2;
+    gen |= pro & (gen << 4);
+    pro &= pro << 4;
+    gen |= pro & (gen << 8);
+    pro &= pro << 8;
+    gen |= pro & (gen << 16);
+    pro &= pro << 16;
+    gen |= pro & (gen << 32);
+
+    return gen;
+}
+
+/**
+ * @brief Spreads bits toward the lower bits (to the left) without crossing
+ *        the zeros of a mask.
+ *
+ * @param gen: Bits to spread (must be inside the mask).
+ * @param pro: Mask of the bits that can be reached.
+ *
+ * @return The spread bits.
+ */
+static inline uint64_t FillLeft(uint64_t gen, uint64_t pro)
+{
+    gen |= pro & (gen >> 1);
+    pro &= pro >> 1;
+    gen |= pro & (gen >> 2);
+    pro &= pro >> 2;
+    gen |= pro & (gen >> 4);
+    pro &= pro >> 4;
+    gen |= pro & (gen >> 8);
+    pro &= pro >> 8;
+    gen |= pro & (gen >> 16);
+    pro &= pro >> 16;
+    gen |= pro & (gen >> 32);
+
+    return gen;
+}
+
+Reachability::Reachability()
+{
+    minX = 0;
+    minY = 0;
+    length = 0;
+    height = 0;
+    nbWords = 0;
+    gridVersion = 0;
+    floodVersion = 0;
+    floodX = 0;
+    floodY = 0;
+    isPacked = false;
+    isFlooded = false;
+}
+
+/*
+ * Checks if a path exists between two points.
+ */
+bool Reachability::IsReachable(const Grid &grid,
+                               int startingPointX, int startingPointY,
+                               int endingPointX, int endingPointY)
+{
+    if(startingPointX == endingPointX && startingPointY == endingPointY)
+    {
+        return false;
+    }
+
+    if(!IsFloodUpToDate(grid, endingPointX, endingPointY))
+    {
+        Flood(grid, endingPointX, endingPointY);
+    }
+
+    return IsReached(startingPointX, startingPointY);
+}
+
+/*
+ * Finds every cube that can be reached from a cube.
+ */
+void Reachability::Flood(const Grid &grid, int x, int y)
+{
+    UpdateOpen(grid);
+
+    reached.assign(open.size(), 0);
+    floodX = x;
+    floodY = y;
+    floodVersion = grid.GetVersion();
+    isFlooded = true;
+
+    int col = x - minX;
+    int row = y - minY;
+
+    if(col < 0 || col >= length || row < 0 || row >= height)
+    {
+        return;
+    }
+
+    int word = row * nbWords + col / 64;
+    uint64_t bit = uint64_t(1) << (col % 64);
+
+    /* The starting cube does not exist or is a wall. */
+    if((open[word] & bit) == 0)
+    {
+        return;
+    }
+
+    int first = col / 64;
+    int last = first;
+
+    reached[word] = bit;
+    FillRow(row, first, last);
+
+    /*
+     * Rows that got new cubes and must spread them to their neighbours. Only
+     * the words that changed since the row was last processed are spread.
+     */
+    dirtyFirst.assign(height, -1);
+    dirtyLast.assign(height, -1);
+    rowQueue.clear();
+    rowQueue.push_back(row);
+    dirtyFirst[row] = first;
+    dirtyLast[row] = last;
+
+    while(!rowQueue.empty())
+    {
+        int current = rowQueue.back();
+        int currentFirst = dirtyFirst[current];
+        int currentLast = dirtyLast[current];
+
+        rowQueue.pop_back();
+        dirtyFirst[current] = -1;
+
+        for(int i : {current - 1, current + 1})
+        {
+            if(i >= 0 && i < height
+               && SpreadRow(current, i, currentFirst, currentLast,
+                            first, last))
+            {
+                FillRow(i, first, last);
+
+                if(dirtyFirst[i] < 0)
+                {
+                    rowQueue.push_back(i);
+                    dirtyFirst[i] = first;
+                    dirtyLast[i] = last;
+                }
+                else
+                {
+                    dirtyFirst[i] = first < dirtyFirst[i] ? first
+                                                          : dirtyFirst[i];
+                    dirtyLast[i] = last > dirtyLast[i] ? last : dirtyLast[i];
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Checks if a cube was reached by the last flood fill.
+ */
+bool Reachability::IsReached(int x, int y) const
+{
+    int col = x - minX;
+    int row = y - minY;
+
+    if(!isFlooded || col < 0 || col >= length || row < 0 || row >= height)
+    {
+        return false;
+    }
+
+    return (reached[row * nbWords + col / 64] >> (col % 64)) & 1;
+}
+
+/*
+ * Checks if the last flood fill is still valid.
+ */
+bool Reachability::IsFloodUpToDate(const Grid &grid, int x, int y) const
+{
+    return isFlooded && floodVersion == grid.GetVersion()
+           && floodX == x && floodY == y;
+}
+
+/*
+ * Updates the walkable bitsets with the walls that changed since the last
+ * update.
+ */
+void Reachability::UpdateOpen(const Grid &grid)
+{
+    if(isPacked && gridVersion == grid.GetVersion())
+    {
+        return;
+    }
+
+    if(isPacked && grid.GetWallChangesSince(gridVersion, changedCubes))
+    {
+        for(auto const &i : changedCubes)
+        {
+            PackCube(grid, i);
+        }
+    }
+    else
+    {
+        Pack(grid);
+    }
+
+    gridVersion = grid.GetVersion();
+    isPacked = true;
+}
+
+/*
+ * Packs the whole grid in the walkable bitsets.
+ */
+void Reachability::Pack(const Grid &grid)
+{
+    minX = grid.GetIndexMinX();
+    minY = grid.GetIndexMinY();
+    length = grid.GetIndexLength();
+    height = grid.GetIndexHeight();
+    nbWords = (length + 63) / 64;
+
+    open.assign(height * nbWords, 0);
+
+    for(unsigned int i = 0; i < grid.cubes.size(); i++)
+    {
+        PackCube(grid, i);
+    }
+}
+
+/*
+ * Updates the walkable bit of a cube.
+ */
+void Reachability::PackCube(const Grid &grid, int index)
+{
+    const Coordinates &position = grid.GetPosition(index);
+
+    /* Only the cube in the coordinate index counts (same as the searches). */
+    if(grid.GetIndex(position.x, position.y) != index)
+    {
+        return;
+    }
+
+    int col = position.x - minX;
+    int row = position.y - minY;
+    uint64_t &word = open[row * nbWords + col / 64];
+    uint64_t bit = uint64_t(1) << (col % 64);
+
+    if(grid.IsWall(index))
+    {
+        word &= ~bit;
+    }
+    else
+    {
+        word |= bit;
+    }
+}
+
+/*
+ * Spreads the reached cubes of a row to the row above or below.
+ */
+bool Reachability::SpreadRow(int fromRow, int toRow, int first, int last,
+                             int &changedFirst, int &changedLast)
+{
+    const uint64_t *from = &reached[fromRow * nbWords];
+    const uint64_t *mask = &open[toRow * nbWords];
+    uint64_t *to = &reached[toRow * nbWords];
+    bool isChanged = false;
+    int i = first;
+
+#if defined(__AVX2__)
+    for(; i + 3 <= last; i += 4)
+    {
+        __m256i vFrom = _mm256_loadu_si256((const __m256i *)(from + i));
+        __m256i vMask = _mm256_loadu_si256((const __m256i *)(mask + i));
+        __m256i vTo = _mm256_loadu_si256((const __m256i *)(to + i));
+
+        /* New cubes: reached above/below, walkable and not reached yet. */
+        __m256i vNew = _mm256_andnot_si256(vTo,
+                                           _mm256_and_si256(vFrom, vMask));
+
+        if(!_mm256_testz_si256(vNew, vNew))
+        {
+            _mm256_storeu_si256((__m256i *)(to + i),
+                                _mm256_or_si256(vTo, vNew));
+
+            if(!isChanged)
+            {
+                changedFirst = i;
+            }
+
+            changedLast = i + 3;
+            isChanged = true;
+        }
+    }
+#endif
+
+    for(; i <= last; i++)
+    {
+        uint64_t newBits = from[i] & mask[i] & ~to[i];
+
+        if(newBits != 0)
+        {
+            to[i] |= newBits;
+
+            if(!isChanged)
+            {
+                changedFirst = i;
+            }
+
+            changedLast = i;
+            isChanged = true;
+        }
+    }
+
+    return isChanged;
+}
+
+/*
+ * Spreads the reached cubes of a row to the left and to the right.
+ */
+void Reachability::FillRow(int row, int &first, int &last)
+{
+    const uint64_t *mask = &open[row * nbWords];
+    uint64_t *bits = &reached[row * nbWords];
+    uint64_t carry = 0;
+
+    /*
+     * Spread to the right, carrying the last bit to the next word. Words
+     * after the range are only visited while the carry reaches new cubes.
+     */
+    for(int i = first; i < nbWords; i++)
+    {
+        uint64_t filled = FillRight(bits[i] | (carry & mask[i]), mask[i]);
+
+        if(filled != bits[i])
+        {
+            bits[i] = filled;
+            last = i > last ? i : last;
+        }
+
+        carry = filled >> 63;
+
+        if(i >= last && (i + 1 == nbWords
+                         || (carry & mask[i + 1] & ~bits[i + 1]) == 0))
+        {
+            break;
+        }
+    }
+
+    carry = 0;
+
+    /* Spread to the left, carrying the first bit to the previous word. */
+    for(int i = last; i >= 0; i--)
+    {
+        uint64_t filled = FillLeft(bits[i] | ((carry << 63) & mask[i]),
+                                   mask[i]);
+
+        if(filled != bits[i])
+        {
+            bits[i] = filled;
+            first = i < first ? i : first;
+        }
+
+        carry = filled & 1;
+
+        if(i <= first && (i == 0
+                          || ((carry << 63) & mask[i - 1] & ~bits[i - 1])
+                             == 0))
+        {
+            break;
+        }
+    }
+}
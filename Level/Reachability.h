@@ -0,0 +1,140 @@
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include <vector>
+#include <cstdint>
+#include "Grid.h"
+
+/**
+ * @brief This class answers "can this cube reach that cube" without searching
+ *        for a path. The walkable cubes of a grid are packed in bitsets (one
+ *        per row) and a flood fill is done on whole 64-bit words at a time:
+ *        every cube reachable from a starting cube is found at once, so the
+ *        answer for every other cube of the map is then O(1).
+ */
+class Reachability
+{
+    public:
+        Reachability();
+
+        /**
+         * @brief Checks if a path exists between two points, like
+         *        Unit::TestPath but without finding the path. The flood fill
+         *        is done from the ending point and kept until the grid
+         *        changes, so checking many starting points for the same
+         *        destination only costs one flood fill.
+         *
+         * @param grid:           Grid of cubes to check.
+         * @param startingPointX: Coordinate in X where the path begins.
+         * @param startingPointY: Coordinate in Y where the path begins.
+         * @param endingPointX:   Coordinate in X where the path ends.
+         * @param endingPointY:   Coordinate in Y where the path ends.
+         *
+         * @return True if a path exists, false otherwise (also false when the
+         *         starting point is the ending point, like Path::FindPath).
+         */
+        bool IsReachable(const Grid &grid,
+                         int startingPointX, int startingPointY,
+                         int endingPointX, int endingPointY);
+
+        /**
+         * @brief Finds every cube that can be reached from a cube.
+         *
+         * @param grid: Grid of cubes to flood.
+         * @param x:    Coordinate in x of the cube to start from.
+         * @param y:    Coordinate in y of the cube to start from.
+         */
+        void Flood(const Grid &grid, int x, int y);
+
+        /**
+         * @brief Checks if a cube was reached by the last flood fill.
+         *
+         * @param x: Coordinate of the cube in x.
+         * @param y: Coordinate of the cube in y.
+         *
+         * @return True if the cube was reached.
+         */
+        bool IsReached(int x, int y) const;
+
+        /**
+         * @brief Checks if the last flood fill started at a cube and was done
+         *        on the current version of the grid.
+         *
+         * @param grid: Grid the flood fill was done on.
+         * @param x:    Coordinate in x of the cube to start from.
+         * @param y:    Coordinate in y of the cube to start from.
+         *
+         * @return True if the flood fill does not need to be done again.
+         */
+        bool IsFloodUpToDate(const Grid &grid, int x, int y) const;
+
+    private:
+        /* Walkable cubes and reached cubes, row by row, bit x of a row. */
+        std::vector<uint64_t> open;
+        std::vector<uint64_t> reached;
+        std::vector<int> changedCubes;
+        std::vector<int> rowQueue;
+        std::vector<int> dirtyFirst;
+        std::vector<int> dirtyLast;
+        int minX;
+        int minY;
+        int length;
+        int height;
+        int nbWords;
+        unsigned int gridVersion;
+        unsigned int floodVersion;
+        int floodX;
+        int floodY;
+        bool isPacked;
+        bool isFlooded;
+
+        /**
+         * @brief Updates the walkable bitsets: only the walls that changed
+         *        are updated when possible, otherwise the whole grid is
+         *        packed again.
+         */
+        void UpdateOpen(const Grid &grid);
+
+        /**
+         * @brief Packs the whole grid in the walkable bitsets.
+         */
+        void Pack(const Grid &grid);
+
+        /**
+         * @brief Updates the walkable bit of a cube.
+         *
+         * @param grid:  Grid containing the cube.
+         * @param index: Index of the cube in the cubes vector.
+         */
+        void PackCube(const Grid &grid, int index);
+
+        /**
+         * @brief Spreads the reached cubes of a range of words of a row to the
+         *        walkable cubes of the row above or below.
+         *
+         * @param fromRow:      Row to spread from.
+         * @param toRow:        Row to spread to.
+         * @param first:        First word of the range.
+         * @param last:         Last word of the range.
+         * @param changedFirst: Set to the first word of toRow that changed.
+         * @param changedLast:  Set to the last word of toRow that changed.
+         *
+         * @return True if new cubes were reached.
+         */
+        bool SpreadRow(int fromRow, int toRow, int first, int last,
+                       int &changedFirst, int &changedLast);
+
+        /**
+         * @brief Spreads the reached cubes of a row to the left and to the
+         *        right until they hit a wall.
+         *
+         * @param row:   Row to fill.
+         * @param first: First word that got new cubes, moved to the first
+         *               word changed by the fill.
+         * @param last:  Last word that got new cubes, moved to the last word
+         *               changed by the fill.
+         */
+        void FillRow(int row, int &first, int &last);
+};
+
+#endif // REACHABILITY_H
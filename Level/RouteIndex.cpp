@@ -0,0 +1,162 @@
+/*
+ * Project: Tower Defense
+ * File: RouteIndex.cpp
+ * Unit test file: TestRouteIndex.cpp
+ *
+ * Brief: This class keeps, for every cube, the units whose route crosses it
+ *        (and for every unit, the cubes of its route to update the index when
+ *        the route changes). Placing a tower then only replans the units
+ *        found on its cube instead of every unit of the wave.
+ */
+
+#include <algorithm>
+#include "RouteIndex.h"
+
+RouteIndex::RouteIndex()
+{
+
+}
+
+/*
+ * Indexes the routes of every unit from scratch.
+ */
+void RouteIndex::Build(const std::vector<Unit> &units, const Grid &grid)
+{
+    cubeUnits.assign(grid.cubes.size(), std::vector<int>());
+    unitCubes.assign(units.size(), std::vector<int>());
+    unitSerials.resize(units.size());
+
+    for(unsigned int i = 0; i < units.size(); i++)
+    {
+        unitSerials[i] = units[i].GetSerial();
+        SetRoute(i, units[i].cubeX, units[i].cubeY,
+                 units[i].GetRouteFromCube(), grid);
+    }
+}
+
+/*
+ * Replaces the route of a unit.
+ */
+void RouteIndex::SetRoute(int unit, int startingPointX, int startingPointY,
+                          const PathView &directions, const Grid &grid)
+{
+    int x = startingPointX;
+    int y = startingPointY;
+
+    if(unit >= (int)unitCubes.size())
+    {
+        unitCubes.resize(unit + 1);
+    }
+
+    if(cubeUnits.size() < grid.cubes.size())
+    {
+        cubeUnits.resize(grid.cubes.size());
+    }
+
+    RemoveRoute(unit);
+
+    for(unsigned int i = 0; i <= directions.size(); i++)
+    {
+        int index = grid.GetIndex(x, y);
+
+        /* The route does not match the grid anymore. */
+        if(index == -1)
+        {
+            break;
+        }
+
+        /* A route can cross the same cube twice only if it loops. */
+        if(cubeUnits[index].empty() || cubeUnits[index].back() != unit)
+        {
+            cubeUnits[index].push_back(unit);
+            unitCubes[unit].push_back(index);
+        }
+
+        if(i == directions.size())
+        {
+            break;
+        }
+
+        switch(directions[i])
+        {
+        case DIRECTION_LEFT:
+            x--;
+            break;
+        case DIRECTION_RIGHT:
+            x++;
+            break;
+        case DIRECTION_UP:
+            y--;
+            break;
+        case DIRECTION_DOWN:
+            y++;
+            break;
+        }
+    }
+}
+
+/*
+ * Removes the route of a unit from the index.
+ */
+void RouteIndex::RemoveRoute(int unit)
+{
+    if(unit < 0 || unit >= (int)unitCubes.size())
+    {
+        return;
+    }
+
+    for(auto const &i : unitCubes[unit])
+    {
+        std::vector<int> &units = cubeUnits[i];
+        auto it = std::find(units.begin(), units.end(), unit);
+
+        if(it != units.end())
+        {
+            *it = units.back();
+            units.pop_back();
+        }
+    }
+
+    unitCubes[unit].clear();
+}
+
+/*
+ * Returns the units whose route crosses a cube.
+ */
+void RouteIndex::GetUnits(int x, int y, const Grid &grid,
+                          std::vector<int> &units) const
+{
+    int index = grid.GetIndex(x, y);
+
+    units.clear();
+
+    if(index == -1 || index >= (int)cubeUnits.size())
+    {
+        return;
+    }
+
+    units = cubeUnits[index];
+}
+
+/*
+ * Checks if the index was built for the same units, in the same order.
+ */
+bool RouteIndex::IsUpToDate(const std::vector<Unit> &units) const
+{
+    if(units.size() != unitSerials.size())
+    {
+        return false;
+    }
+
+    for(unsigned int i = 0; i < units.size(); i++)
+    {
+        if(units[i].GetSerial() != unitSerials[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int RouteIndex::GetNbUnits() const { return unitCubes.size(); }
@@ -0,0 +1,91 @@
+#ifndef ROUTEINDEX_H
+#define ROUTEINDEX_H
+
+#include <vector>
+#include "Grid.h"
+#include "PackedPath.h"
+#include "../Entities/Unit.h"
+
+/**
+ * @brief Reverse index from the cubes to the units whose route crosses them.
+ *        When a tower is placed on a cube, only the units found here need a
+ *        new path. Units are identified by their position in the units
+ *        vector of the level, so the index must be rebuilt when the units
+ *        vector changes (see IsUpToDate).
+ *
+ * @note The cubes already walked stay in the index until the unit gets a new
+ *       route, so a unit can be found for a cube it already left (it is then
+ *       only replanned for nothing).
+ */
+class RouteIndex
+{
+    public:
+        RouteIndex();
+
+        /**
+         * @brief Indexes the routes of every unit from scratch.
+         *
+         * @param units: Units of the level (the routes start at their cube,
+         *               see Unit::GetRouteFromCube).
+         * @param grid:  Grid the routes were found on.
+         */
+        void Build(const std::vector<Unit> &units, const Grid &grid);
+
+        /**
+         * @brief Replaces the route of a unit.
+         *
+         * @param unit:           Position of the unit in the units vector.
+         * @param startingPointX: Coordinate in X where the route begins.
+         * @param startingPointY: Coordinate in Y where the route begins.
+         * @param directions:     Directions of the route.
+         * @param grid:           Grid the route was found on.
+         */
+        void SetRoute(int unit, int startingPointX, int startingPointY,
+                      const PathView &directions, const Grid &grid);
+
+        /**
+         * @brief Removes the route of a unit from the index.
+         *
+         * @param unit: Position of the unit in the units vector.
+         */
+        void RemoveRoute(int unit);
+
+        /**
+         * @brief Returns the units whose route crosses a cube.
+         *
+         * @param x:     Coordinate of the cube in x.
+         * @param y:     Coordinate of the cube in y.
+         * @param grid:  Grid of cubes.
+         * @param units: Vector where we store the positions of the units.
+         */
+        void GetUnits(int x, int y, const Grid &grid,
+                      std::vector<int> &units) const;
+
+        /**
+         * @brief Checks if the index was built for the same units, in the
+         *        same order (units added, removed or moved in the vector
+         *        since the last Build make it outdated).
+         *
+         * @param units: Units of the level.
+         *
+         * @return True if the positions of the units are still valid.
+         */
+        bool IsUpToDate(const std::vector<Unit> &units) const;
+
+        /**
+         * @return Number of units indexed.
+         */
+        int GetNbUnits() const;
+
+    private:
+        /* Serial numbers of the units indexed by the last Build. */
+        std::vector<unsigned int> unitSerials;
+
+        /* Units whose route crosses a cube, by cube index. */
+        std::vector<std::vector<int>> cubeUnits;
+
+        /* Cubes crossed by the route of a unit, by unit. */
+        std::vector<std::vector<int>> unitCubes;
+};
+
+#endif // ROUTEINDEX_H
@@ -0,0 +1,123 @@
+/*
+ * Project: Tower Defense
+ * File: ThreadPool.cpp
+ *
+ * Brief: This class contains a small pool of worker threads. A job is a number
+ *        of items and a task; the items are taken one by one (with an atomic
+ *        counter) by the workers and by the thread that started the job, which
+ *        waits until every worker is done before returning.
+ */
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int nbThreads)
+{
+    task = nullptr;
+    nextItem = 0;
+    nbItems = 0;
+    nbBusyWorkers = 0;
+    jobId = 0;
+    isStopping = false;
+
+    if(nbThreads <= 0)
+    {
+        nbThreads = std::thread::hardware_concurrency();
+    }
+
+    /* The calling thread of Run also processes items. */
+    for(int i = 1; i < nbThreads; i++)
+    {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+
+    jobCondition.notify_all();
+
+    for(auto &i : workers)
+    {
+        i.join();
+    }
+}
+
+/*
+ * Calls the task for every item and returns once all the items are done.
+ */
+void ThreadPool::Run(int nbItems, const std::function<void(int)> &task)
+{
+    if(nbItems <= 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(runMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        this->nbItems = nbItems;
+        nextItem = 0;
+        nbBusyWorkers = workers.size();
+        jobId++;
+    }
+
+    jobCondition.notify_all();
+    ProcessItems();
+
+    /* The task must stay alive until every worker stopped using it. */
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]{ return nbBusyWorkers == 0; });
+    this->task = nullptr;
+}
+
+/*
+ * Loop of a worker thread.
+ */
+void ThreadPool::WorkerLoop()
+{
+    unsigned int lastJobId = 0;
+
+    for(;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobCondition.wait(lock, [this, lastJobId]
+                              { return isStopping || jobId != lastJobId; });
+
+            if(isStopping)
+            {
+                return;
+            }
+
+            lastJobId = jobId;
+        }
+
+        ProcessItems();
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(--nbBusyWorkers == 0)
+        {
+            doneCondition.notify_one();
+        }
+    }
+}
+
+/*
+ * Processes items of the current job until there are none left.
+ */
+void ThreadPool::ProcessItems()
+{
+    for(int item = nextItem++; item < nbItems; item = nextItem++)
+    {
+        (*task)(item);
+    }
+}
+
+int ThreadPool::GetNbThreads() const { return workers.size() + 1; }
@@ -0,0 +1,70 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+/**
+ * @brief Small pool of worker threads used to run the same task on many
+ *        independent items (for example one path search per item). The
+ *        threads are created once and wait between two calls to Run.
+ */
+class ThreadPool
+{
+    public:
+        /**
+         * @param nbThreads: Number of threads used by Run (counting the
+         *                   calling thread). 0 uses the number of hardware
+         *                   threads.
+         */
+        ThreadPool(int nbThreads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Calls task(item) for every item in [0, nbItems[ and returns
+         *        once all the items are done. Items are shared between the
+         *        worker threads and the calling thread, in no particular
+         *        order, so the task must only write to data owned by its item.
+         *        Calls to Run from different threads are done one at a time.
+         *
+         * @param nbItems: Number of items to process.
+         * @param task:    Function called for each item.
+         */
+        void Run(int nbItems, const std::function<void(int)> &task);
+
+        /* Getters. */
+        int GetNbThreads() const;
+
+    private:
+        std::vector<std::thread> workers;
+        std::mutex runMutex;
+        std::mutex mutex;
+        std::condition_variable jobCondition;
+        std::condition_variable doneCondition;
+        const std::function<void(int)> *task;
+        std::atomic<int> nextItem;
+        int nbItems;
+        int nbBusyWorkers;
+        unsigned int jobId;
+        bool isStopping;
+
+        /**
+         * @brief Loop of a worker thread: waits for a job and helps with it.
+         */
+        void WorkerLoop();
+
+        /**
+         * @brief Processes items of the current job until there are none
+         *        left.
+         */
+        void ProcessItems();
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,234 @@
+/*
+ * Project: Tower Defense
+ * File: TIndexedHeap.h
+ *
+ * Brief: Contains an indexed binary min-heap template used as the open set of
+ *        the pathfinding algorithms. Every element is identified by an index
+ *        (usually the index of a cube in the grid), which allows the key of an
+ *        element already in the heap to be changed in O(log n).
+ */
+
+#ifndef TINDEXEDHEAP_H_INCLUDED
+#define TINDEXEDHEAP_H_INCLUDED
+
+#include <vector>
+
+/**
+ * @brief Indexed binary min-heap. Elements are indexes between 0 and the
+ *        capacity given to Reset(), ordered by a key of type T (T must
+ *        provide operator<).
+ */
+template <class T>
+class IndexedHeap
+{
+    public:
+        /**
+         * @brief Empties the heap and makes room for indexes in the range
+         *        [0, capacity[.
+         *
+         * @param capacity: Number of indexes the heap can hold.
+         */
+        void Reset(int capacity)
+        {
+            Clear();
+
+            if(static_cast<int>(positions.size()) != capacity)
+            {
+                positions.assign(capacity, -1);
+            }
+        }
+
+        /**
+         * @brief Empties the heap (the capacity stays the same). Only costs
+         *        the number of elements currently in the heap.
+         */
+        void Clear()
+        {
+            for(auto const &i : nodes)
+            {
+                positions[i.index] = -1;
+            }
+
+            nodes.clear();
+        }
+
+        /**
+         * @brief Inserts an index in the heap or changes its key if it is
+         *        already in the heap.
+         *
+         * @param index: Index of the element.
+         * @param key:   Key of the element.
+         */
+        void Push(int index, const T &key)
+        {
+            int pos = positions[index];
+
+            if(pos < 0)
+            {
+                nodes.push_back({index, key});
+                positions[index] = nodes.size() - 1;
+                SiftUp(nodes.size() - 1);
+            }
+            else if(key < nodes[pos].key)
+            {
+                nodes[pos].key = key;
+                SiftUp(pos);
+            }
+            else
+            {
+                nodes[pos].key = key;
+                SiftDown(pos);
+            }
+        }
+
+        /**
+         * @brief Removes the element with the smallest key from the heap.
+         *
+         * @return The index of the removed element or -1 if the heap is
+         *         empty.
+         */
+        int Pop()
+        {
+            int index = -1;
+
+            if(!nodes.empty())
+            {
+                index = nodes[0].index;
+                Remove(index);
+            }
+
+            return index;
+        }
+
+        /**
+         * @brief Removes an element from the heap (does nothing if the
+         *        element is not in the heap).
+         *
+         * @param index: Index of the element to remove.
+         */
+        void Remove(int index)
+        {
+            int pos = positions[index];
+
+            if(pos >= 0)
+            {
+                int last = nodes.size() - 1;
+
+                positions[index] = -1;
+
+                if(pos != last)
+                {
+                    int moved = nodes[last].index;
+
+                    nodes[pos] = nodes[last];
+                    positions[moved] = pos;
+                    nodes.pop_back();
+
+                    /* The last node may need to go either up or down. */
+                    SiftUp(pos);
+                    SiftDown(positions[moved]);
+                }
+                else
+                {
+                    nodes.pop_back();
+                }
+            }
+        }
+
+        /**
+         * @return True if the index is currently in the heap.
+         */
+        bool Contains(int index) const
+        {
+            return index >= 0 && index < static_cast<int>(positions.size())
+                   && positions[index] >= 0;
+        }
+
+        /**
+         * @return Index of the element with the smallest key (the heap must
+         *         not be empty).
+         */
+        int Top() const { return nodes[0].index; }
+
+        /**
+         * @return Smallest key of the heap (the heap must not be empty).
+         */
+        const T &TopKey() const { return nodes[0].key; }
+
+        bool IsEmpty() const { return nodes.empty(); }
+
+        int GetSize() const { return nodes.size(); }
+
+    private:
+        typedef struct Node{
+            int index;
+            T key;
+        } Node;
+
+        std::vector<Node> nodes;
+        std::vector<int> positions;
+
+        /**
+         * @brief Moves a node up the heap until its parent has a smaller key.
+         */
+        void SiftUp(int pos)
+        {
+            Node node = nodes[pos];
+
+            while(pos > 0)
+            {
+                int parent = (pos - 1) / 2;
+
+                if(!(node.key < nodes[parent].key))
+                {
+                    break;
+                }
+
+                nodes[pos] = nodes[parent];
+                positions[nodes[pos].index] = pos;
+                pos = parent;
+            }
+
+            nodes[pos] = node;
+            positions[node.index] = pos;
+        }
+
+        /**
+         * @brief Moves a node down the heap until its children have bigger
+         *        keys.
+         */
+        void SiftDown(int pos)
+        {
+            int size = nodes.size();
+            Node node = nodes[pos];
+
+            for(;;)
+            {
+                int child = pos * 2 + 1;
+
+                if(child >= size)
+                {
+                    break;
+                }
+
+                if(child + 1 < size && nodes[child + 1].key < nodes[child].key)
+                {
+                    child++;
+                }
+
+                if(!(nodes[child].key < node.key))
+                {
+                    break;
+                }
+
+                nodes[pos] = nodes[child];
+                positions[nodes[pos].index] = pos;
+                pos = child;
+            }
+
+            nodes[pos] = node;
+            positions[node.index] = pos;
+        }
+};
+
+#endif // TINDEXEDHEAP_H_INCLUDED
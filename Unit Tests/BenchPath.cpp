@@ -0,0 +1,455 @@
+/*
+ * Benchmarked class: Path
+ *
+ * This file benchmarks the FindPath method of the Path class on open and
+ * mazed square grids of different sizes, and FindPaths with batches of
+ * searches on different numbers of threads. The benchmarks are hidden from the
+ * default test run, use the "[benchmark]" tag to run them.
+ *
+ * The "[catch]" benchmarks use the Catch BENCHMARK macro (mean, standard
+ * deviation and outliers, also written by the xml reporter) on open, mazed
+ * and blocked grids, and write the nodes expanded per second of every case
+ * in benchmark_pathfinding.csv so results can be compared between versions.
+ *
+ * "Benchmark the layout of the cube data" compares reading the cubes with
+ * reading the packed arrays of the grid, in an order that makes most reads
+ * cache misses once the grid is large.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include "../~External Libraries/catch.hpp"
+#include "../Level/Path.h"
+#include "../Level/PathScratch.h"
+#include "../Entities/Unit.h"
+#include "../Level/ThreadPool.h"
+#include "../Level/Reachability.h"
+
+/**
+ * @brief Types of grids of the benchmarks: open, mazed (every odd column
+ *        except the last one is a wall with a single opening alternating
+ *        between the top and the bottom, which forces the path to snake
+ *        through the whole grid) and blocked (open, but the middle column is a
+ *        wall, so a search visits every cube of its half before failing).
+ */
+enum BENCH_GRID{BENCH_GRID_OPEN, BENCH_GRID_MAZED, BENCH_GRID_BLOCKED};
+
+static const char *benchGridNames[] = {"open", "mazed", "blocked"};
+
+/**
+ * @brief Creates a square grid of cubes of the benchmarks.
+ *
+ * @param size: Length of a side of the grid.
+ * @param type: Type of grid (BENCH_GRID).
+ *
+ * @return Grid containing the cubes.
+ */
+static Grid CreateBenchGrid(int size, BENCH_GRID type)
+{
+    Grid grid;
+    std::vector<Cube> &cubes = grid.cubes;
+    cubes.reserve(size * size);
+
+    for(int x = 0; x < size; x++)
+    {
+        for(int y = 0; y < size; y++)
+        {
+            bool isWall = type == BENCH_GRID_BLOCKED && x == size / 2;
+
+            if(type == BENCH_GRID_MAZED && x % 2 == 1 && x < size - 1)
+            {
+                int opening = (x / 2) % 2 == 0 ? size - 1 : 0;
+                isWall = y != opening;
+            }
+
+            cubes.push_back(Cube(x, y, 0, 0, isWall));
+        }
+    }
+
+    grid.BuildIndex();
+
+    return grid;
+}
+
+/**
+ * @brief Times FindPath from a corner of a grid to the opposite corner and
+ *        prints the average time of a search.
+ *
+ * @param size: Length of a side of the grid.
+ * @param type: Type of grid (BENCH_GRID_OPEN or BENCH_GRID_MAZED).
+ */
+static void BenchFindPath(int size, BENCH_GRID type)
+{
+    Grid grid = CreateBenchGrid(size, type);
+    Path path;
+    int nbRuns = size <= 50 ? 1000 : (size <= 100 ? 100 : 10);
+    int last = size - 1;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < nbRuns; i++)
+    {
+        path.FindPath(0, 0, last, last, grid);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+
+    std::cout << benchGridNames[type] << " " << size << "x" << size << ": "
+              << ms / nbRuns << " ms per search ("
+              << path.GetDirections().size() << " steps)\n";
+
+    REQUIRE(path.GetDirections().size() > 0);
+}
+
+TEST_CASE("Benchmark FindPath on open grids", "[.][benchmark][Pathfinder]")
+{
+    for(int size : {10, 50, 100, 200, 500})
+    {
+        BenchFindPath(size, BENCH_GRID_OPEN);
+    }
+}
+
+TEST_CASE("Benchmark FindPath on mazed grids", "[.][benchmark][Pathfinder]")
+{
+    for(int size : {10, 50, 100, 200, 500})
+    {
+        BenchFindPath(size, BENCH_GRID_MAZED);
+    }
+}
+
+TEST_CASE("Benchmark FindPaths batches", "[.][benchmark][Pathfinder]")
+{
+    Grid grid = CreateBenchGrid(200, BENCH_GRID_MAZED);
+    std::vector<PathQuery> queries;
+    std::vector<Path> paths;
+
+    /* 256 units spawning on the first column, going to the last corner. */
+    for(int i = 0; i < 256; i++)
+    {
+        queries.push_back({0, i % 200, 199, 199});
+    }
+
+    for(int nbThreads : {1, 2, 4, 8})
+    {
+        ThreadPool pool(nbThreads);
+
+        auto begin = std::chrono::steady_clock::now();
+        int nbPathsFound = Path::FindPaths(queries, grid, paths, pool);
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - begin)
+                    .count();
+
+        std::cout << "batch of " << queries.size() << " on " << nbThreads
+                  << " threads: " << ms << " ms\n";
+
+        REQUIRE(nbPathsFound == static_cast<int>(queries.size()));
+    }
+}
+
+/**
+ * @brief Times a flood fill from a corner of a grid and prints the average
+ *        time of a flood fill.
+ *
+ * @param size: Length of a side of the grid.
+ * @param type: Type of grid (BENCH_GRID_OPEN or BENCH_GRID_MAZED).
+ */
+static void BenchFlood(int size, BENCH_GRID type)
+{
+    Grid grid = CreateBenchGrid(size, type);
+    Reachability reachability;
+    int nbRuns = 100;
+    int last = size - 1;
+    bool isReachable = false;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < nbRuns; i++)
+    {
+        reachability.Flood(grid, last, last);
+        isReachable = reachability.IsReached(0, 0);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+
+    std::cout << "flood " << benchGridNames[type] << " " << size << "x"
+              << size << ": " << ms / nbRuns << " ms\n";
+
+    REQUIRE(isReachable);
+}
+
+TEST_CASE("Benchmark Reachability", "[.][benchmark][Reachability]")
+{
+    for(int size : {50, 100, 200, 500})
+    {
+        BenchFlood(size, BENCH_GRID_OPEN);
+        BenchFlood(size, BENCH_GRID_MAZED);
+    }
+}
+
+/**
+ * @brief Reads the coordinates and the wall state of every cube of an open
+ *        grid in a random order, once from the cubes and once from the packed
+ *        arrays of the grid, and prints the bytes read per cube, the memory
+ *        spanned by the data read and the time per cube. The random order
+ *        defeats the prefetcher, so once the data no longer fits in the
+ *        caches the time per cube is mostly the time of a cache miss, and
+ *        the two layouts can be compared without hardware counters.
+ *
+ * @param size: Length of a side of the grid.
+ */
+static void BenchCubeLayout(int size)
+{
+    Grid grid = CreateBenchGrid(size, BENCH_GRID_OPEN);
+    std::vector<int> order(grid.cubes.size());
+    std::mt19937 generator(size);
+    int nbRuns = size <= 500 ? 10 : 3;
+    long sumCubes = 0;
+    long sumPacked = 0;
+
+    for(unsigned int i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+
+    std::shuffle(order.begin(), order.end(), generator);
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for(int run = 0; run < nbRuns; run++)
+    {
+        for(auto const &i : order)
+        {
+            const Cube &cube = grid.cubes[i];
+            sumCubes += cube.IsWall() ? 0 : cube.coordX + cube.coordY;
+        }
+    }
+
+    auto middle = std::chrono::steady_clock::now();
+
+    for(int run = 0; run < nbRuns; run++)
+    {
+        for(auto const &i : order)
+        {
+            const Coordinates &position = grid.GetPosition(i);
+            sumPacked += grid.IsWall(i) ? 0 : position.x + position.y;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double nbReads = double(nbRuns) * order.size();
+    double cubesNs = std::chrono::duration<double, std::nano>(middle - begin)
+                     .count() / nbReads;
+    double packedNs = std::chrono::duration<double, std::nano>(end - middle)
+                      .count() / nbReads;
+    long packedBytes = sizeof(Coordinates) + sizeof(char);
+
+    std::cout << "layout " << size << "x" << size << ": cubes "
+              << sizeof(Cube) << " B/cube, "
+              << sizeof(Cube) * order.size() / 1024 << " KiB, " << cubesNs
+              << " ns/cube; packed " << packedBytes << " B/cube, "
+              << packedBytes * order.size() / 1024 << " KiB, " << packedNs
+              << " ns/cube\n";
+
+    REQUIRE(sumCubes == sumPacked);
+}
+
+TEST_CASE("Benchmark the layout of the cube data",
+          "[.][benchmark][Grid]")
+{
+    for(int size : {50, 200, 500, 1000, 2000})
+    {
+        BenchCubeLayout(size);
+    }
+}
+
+/**
+ * @brief Times FindPathHierarchical from a corner of a grid to the opposite
+ *        corner and prints the time of the first search (which computes the
+ *        clusters) and the average time of the next searches.
+ *
+ * @param size: Length of a side of the grid.
+ * @param type: Type of grid (BENCH_GRID_OPEN or BENCH_GRID_MAZED).
+ */
+static void BenchFindPathHierarchical(int size, BENCH_GRID type)
+{
+    Grid grid = CreateBenchGrid(size, type);
+    Path path;
+    int nbRuns = 10;
+    int last = size - 1;
+
+    auto begin = std::chrono::steady_clock::now();
+    path.FindPathHierarchical(0, 0, last, last, grid);
+    auto built = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < nbRuns; i++)
+    {
+        path.FindPathHierarchical(0, 0, last, last, grid);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double buildMs = std::chrono::duration<double, std::milli>(built - begin)
+                     .count();
+    double ms = std::chrono::duration<double, std::milli>(end - built).count();
+
+    std::cout << "hierarchical " << benchGridNames[type] << " " << size
+              << "x" << size << ": first search " << buildMs << " ms, then "
+              << ms / nbRuns << " ms per search ("
+              << path.GetDirections().size() << " steps)\n";
+
+    REQUIRE(path.GetDirections().size() > 0);
+}
+
+TEST_CASE("Benchmark FindPathHierarchical",
+          "[.][benchmark][HierarchicalPath]")
+{
+    for(int size : {100, 200, 500})
+    {
+        BenchFindPathHierarchical(size, BENCH_GRID_OPEN);
+        BenchFindPathHierarchical(size, BENCH_GRID_MAZED);
+    }
+}
+
+/* File where the nodes expanded per second are written. */
+#define BENCH_CSV_FILE "benchmark_pathfinding.csv"
+
+/* Minimum time spent timing a case for the CSV file, in milliseconds. */
+#define BENCH_CSV_MIN_TIME 200.0
+
+/**
+ * @brief Times a function until BENCH_CSV_MIN_TIME is spent and writes a line
+ *        in the CSV file (which is emptied by the first line of a run).
+ *
+ * @param benchmark: Name of the benchmarked method.
+ * @param type:      Type of grid (BENCH_GRID).
+ * @param size:      Length of a side of the grid.
+ * @param nbNodes:   Number of nodes expanded by one call of the function.
+ * @param function:  Function to time.
+ */
+static void WriteBenchCsv(const std::string &benchmark, BENCH_GRID type,
+                          int size, long nbNodes,
+                          const std::function<void()> &function)
+{
+    static bool isFileCreated = false;
+    std::ofstream csvFile;
+    int nbRuns = 0;
+    double ms = 0.0;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    while(ms < BENCH_CSV_MIN_TIME || nbRuns < 3)
+    {
+        function();
+        nbRuns++;
+        ms = std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - begin).count();
+    }
+
+    double us = ms * 1000.0 / nbRuns;
+
+    if(!isFileCreated)
+    {
+        csvFile.open(BENCH_CSV_FILE, std::ios::trunc);
+        csvFile << "benchmark,grid,size,nodes,mean_us,nodes_per_sec\n";
+        isFileCreated = true;
+    }
+    else
+    {
+        csvFile.open(BENCH_CSV_FILE, std::ios::app);
+    }
+
+    csvFile << benchmark << "," << benchGridNames[type] << "," << size << ","
+            << nbNodes << "," << us << "," << (long)(nbNodes / us * 1e6)
+            << "\n";
+}
+
+TEST_CASE("Benchmark FindPath with Catch",
+          "[.][benchmark][catch][Pathfinder]")
+{
+    for(BENCH_GRID type : {BENCH_GRID_OPEN, BENCH_GRID_MAZED,
+                           BENCH_GRID_BLOCKED})
+    {
+        for(int size : {50, 100, 250, 500})
+        {
+            Grid grid = CreateBenchGrid(size, type);
+            PathScratch scratch;
+            Path path;
+            int last = size - 1;
+            std::string name = std::string("FindPath ") + benchGridNames[type]
+                               + " " + std::to_string(size) + "x"
+                               + std::to_string(size);
+
+            bool isFound = path.FindPath(0, 0, last, last, grid, scratch);
+            REQUIRE(isFound == (type != BENCH_GRID_BLOCKED));
+
+            BENCHMARK(std::string(name))
+            {
+                return path.FindPath(0, 0, last, last, grid, scratch);
+            };
+
+            WriteBenchCsv("FindPath", type, size, scratch.GetNbClosed(), [&]
+            {
+                path.FindPath(0, 0, last, last, grid, scratch);
+            });
+        }
+    }
+}
+
+TEST_CASE("Benchmark TestPath with Catch",
+          "[.][benchmark][catch][Pathfinder]")
+{
+    for(BENCH_GRID type : {BENCH_GRID_OPEN, BENCH_GRID_MAZED,
+                           BENCH_GRID_BLOCKED})
+    {
+        for(int size : {50, 100, 250, 500})
+        {
+            Grid grid = CreateBenchGrid(size, type);
+            Unit unit(0, 10, 1, 1, 0);
+            Reachability reachability;
+            int last = size - 1;
+            long nbNodes = 0;
+            std::string name = std::string("TestPath ") + benchGridNames[type]
+                               + " " + std::to_string(size) + "x"
+                               + std::to_string(size);
+
+            /*
+             * TestPath keeps the flood fill of the last ending point, so two
+             * ending points are alternated to flood every time. The nodes are
+             * the cubes reached by both flood fills.
+             */
+            for(int endingPointY : {last, 0})
+            {
+                reachability.Flood(grid, last, endingPointY);
+
+                for(auto const &i : grid.cubes)
+                {
+                    nbNodes += reachability.IsReached(i.coordX, i.coordY);
+                }
+            }
+
+            REQUIRE(unit.TestPath(0, 0, last, 0, grid)
+                    == (type != BENCH_GRID_BLOCKED));
+
+            BENCHMARK(std::string(name))
+            {
+                return unit.TestPath(0, 0, last, last, grid)
+                       + unit.TestPath(0, 0, last, 0, grid);
+            };
+
+            WriteBenchCsv("TestPath", type, size, nbNodes, [&]
+            {
+                unit.TestPath(0, 0, last, last, grid);
+                unit.TestPath(0, 0, last, 0, grid);
+            });
+        }
+    }
+}
@@ -129,3 +129,35 @@ TEST_CASE("Tests for SetMaxZoom", "[Camera]")
         REQUIRE(camera.GetMaxZoom() == baseMinZoom);
     }
 }
+
+TEST_CASE("Tests for Camera GetVersion", "[Camera]")
+{
+    Camera camera;
+    camera.SetMinZoom(0.5f);
+    camera.SetMaxZoom(2.0f);
+    camera.SetZoom(1.0f);
+    unsigned int version = camera.GetVersion();
+
+    int savedMouseX = 0;
+    int savedMouseY = 0;
+    int currMouseX = 3;
+    int currMouseY = 4;
+
+    SECTION("Test GetVersion after moving the camera.")
+    {
+        camera.MoveCamera(savedMouseX, savedMouseY, currMouseX, currMouseY);
+        REQUIRE(camera.GetVersion() != version);
+    }
+
+    SECTION("Test GetVersion after zooming.")
+    {
+        camera.Zoom(0.2f);
+        REQUIRE(camera.GetVersion() != version);
+    }
+
+    SECTION("Test GetVersion with a refused zoom.")
+    {
+        camera.Zoom(4.0f);
+        REQUIRE(camera.GetVersion() == version);
+    }
+}
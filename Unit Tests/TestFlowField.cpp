@@ -0,0 +1,201 @@
+/*
+ * Tested class: FlowField
+ *
+ * This file unit tests the scenarios for the methods in the FlowField class.
+ */
+
+#include "../~External Libraries/catch.hpp"
+#include "../Level/FlowField.h"
+#include "../Level/Level.h"
+
+TEST_CASE("Tests for FlowField", "[FlowField]")
+{
+    Grid grid;
+    FlowField flowField;
+    std::vector<int> directions;
+
+    /*
+     * Same pattern as the pathfinder tests.
+     * o represents walkable areas.
+     * x represents walls.
+     * Spaces represent empty grid cells.
+     *
+     * Grid setup:
+     * o oo
+     * oxox
+     * oooo
+     */
+    for(int x = 0; x < 3; x++)
+    {
+        for(int y = 0; y < 4; y++)
+        {
+            if(x != 0 || y != 2)
+            {
+                grid.AddCube(x, y, 0, 0);
+            }
+        }
+    }
+
+    grid.SetWall(1, 0, true);
+    grid.SetWall(1, 2, true);
+    flowField.Build(grid, 0, 3);
+
+    SECTION("Test distances to the destination")
+    {
+        REQUIRE(flowField.GetDistance(grid, 0, 3) == 0);
+        REQUIRE(flowField.GetDistance(grid, 0, 0) == 7);
+        REQUIRE(flowField.GetDistance(grid, 1, 0) == -1);
+        REQUIRE(flowField.GetDistance(grid, -5, -5) == -1);
+    }
+
+    SECTION("Test TracePath with path navigating through obstacles")
+    {
+        REQUIRE(flowField.TracePath(grid, 0, 0, directions) == true);
+        REQUIRE(directions.size() == 7);
+        REQUIRE(directions.at(0) == DIRECTION_DOWN);
+        REQUIRE(directions.at(1) == DIRECTION_RIGHT);
+        REQUIRE(directions.at(2) == DIRECTION_RIGHT);
+        REQUIRE(directions.at(6) == DIRECTION_LEFT);
+    }
+
+    SECTION("Test TracePath with starting point same as the destination")
+    {
+        REQUIRE(flowField.TracePath(grid, 0, 3, directions) == false);
+        REQUIRE(directions.size() == 0);
+    }
+
+    SECTION("Test IsUpToDate after placing a wall")
+    {
+        REQUIRE(flowField.IsUpToDate(grid, 0, 3));
+        grid.SetWall(1, 3, true);
+        REQUIRE_FALSE(flowField.IsUpToDate(grid, 0, 3));
+
+        flowField.Build(grid, 0, 3);
+        REQUIRE(flowField.GetDistance(grid, 2, 3) == -1);
+        REQUIRE(flowField.GetDistance(grid, 0, 0) == -1);
+        REQUIRE(flowField.TracePath(grid, 0, 0, directions) == false);
+    }
+}
+
+TEST_CASE("Tests for FlowField with several destinations", "[FlowField]")
+{
+    Grid grid;
+    FlowField flowField;
+    std::vector<int> directions;
+    std::vector<Coordinates> destinations = {{0, 0}, {4, 4}};
+
+    /* Open 5 x 5 grid with a destination in two corners. */
+    for(int x = 0; x < 5; x++)
+    {
+        for(int y = 0; y < 5; y++)
+        {
+            grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    flowField.Build(grid, destinations);
+
+    SECTION("Test distances to the closest destination")
+    {
+        REQUIRE(flowField.GetDistance(grid, 0, 0) == 0);
+        REQUIRE(flowField.GetDistance(grid, 4, 4) == 0);
+        REQUIRE(flowField.GetDistance(grid, 1, 1) == 2);
+        REQUIRE(flowField.GetDistance(grid, 3, 4) == 1);
+        REQUIRE(flowField.GetDistance(grid, 4, 0) == 4);
+    }
+
+    SECTION("Test TracePath leads to the closest destination")
+    {
+        REQUIRE(flowField.TracePath(grid, 3, 3, directions) == true);
+        REQUIRE(directions.size() == 2);
+        REQUIRE(flowField.TracePath(grid, 0, 2, directions) == true);
+        REQUIRE(directions.size() == 2);
+        REQUIRE(directions.at(0) == DIRECTION_UP);
+    }
+
+    SECTION("Test that invalid destinations are ignored")
+    {
+        grid.SetWall(4, 4, true);
+        destinations.push_back({-5, -5});
+
+        REQUIRE_FALSE(flowField.IsUpToDate(grid, destinations));
+        flowField.Build(grid, destinations);
+        REQUIRE(flowField.IsUpToDate(grid, destinations));
+
+        REQUIRE(flowField.GetDistance(grid, 4, 4) == -1);
+        REQUIRE(flowField.GetDistance(grid, 3, 4) == 7);
+    }
+
+    SECTION("Test IsUpToDate with the destinations")
+    {
+        REQUIRE(flowField.IsUpToDate(grid, destinations));
+        REQUIRE_FALSE(flowField.IsUpToDate(grid, 0, 0));
+        REQUIRE_FALSE(flowField.IsUpToDate(grid, {{0, 0}}));
+        REQUIRE_FALSE(flowField.IsUpToDate(grid, {{4, 4}, {0, 0}}));
+
+        flowField.Build(grid, 0, 0);
+        REQUIRE(flowField.IsUpToDate(grid, 0, 0));
+        REQUIRE(flowField.IsUpToDate(grid, {{0, 0}}));
+    }
+}
+
+TEST_CASE("Tests for FindUnitPaths with several destinations", "[FlowField]")
+{
+    Level level;
+
+    /* Open 5 x 5 grid with a destination in two corners. */
+    for(int x = 0; x < 5; x++)
+    {
+        for(int y = 0; y < 5; y++)
+        {
+            level.grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    level.destinations = {{0, 0}, {4, 4}};
+    level.destination = level.destinations[0];
+
+    for(int i = 0; i < 3; i++)
+    {
+        level.units.push_back(Unit(0, 10, 1, 1, 0));
+    }
+
+    level.units[0].cubeX = 1;
+    level.units[0].cubeY = 0;
+    level.units[1].cubeX = 4;
+    level.units[1].cubeY = 2;
+    level.units[2].cubeX = 4;
+    level.units[2].cubeY = 2;
+
+    level.FindUnitPaths();
+
+    SECTION("Test that every unit goes to its closest destination")
+    {
+        REQUIRE(level.units[0].path.GetDirections().size() == 1);
+        REQUIRE(level.units[1].path.GetDirections().size() == 2);
+    }
+
+    SECTION("Test that the units on the same cube get the same path")
+    {
+        PathView first = level.units[1].path.GetDirections();
+        PathView second = level.units[2].path.GetDirections();
+
+        REQUIRE(second.size() == first.size());
+
+        for(unsigned int i = 0; i < first.size(); i++)
+        {
+            REQUIRE(second[i] == first[i]);
+        }
+    }
+
+    SECTION("Test that the units are replanned to the other destination")
+    {
+        /* Blocks the exit (4, 4). */
+        level.grid.SetWall(4, 3, true);
+        level.grid.SetWall(3, 4, true);
+
+        REQUIRE(level.ReplanAffectedUnits(4, 3) == 2);
+        REQUIRE(level.units[1].path.GetDirections().size() == 6);
+        REQUIRE(level.units[0].path.GetDirections().size() == 1);
+    }
+}
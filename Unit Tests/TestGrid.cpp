@@ -7,6 +7,7 @@
  * class.
  */
 
+#include <algorithm>
 #include "../~External Libraries/catch.hpp"
 #include "../Level/Grid.h"
 
@@ -32,6 +33,47 @@ TEST_CASE("Tests for CalculateLowestRowPlusCol", "[Grid]")
     {
         REQUIRE(grid.GetLowestRowPlusCol() == -4);
     }
+
+    SECTION("Test that adding cubes keeps it up to date.")
+    {
+        grid.AddCube(-10, 2, 0, 0);
+        REQUIRE(grid.GetLowestRowPlusCol() == -8);
+
+        grid.AddCube(40, 40, 0, 0);
+        REQUIRE(grid.GetLowestRowPlusCol() == -8);
+    }
+
+    SECTION("Test that moving cubes keeps it up to date.")
+    {
+        grid.MoveCube(grid.cubes[2], 5, 5, 0);
+        REQUIRE(grid.GetLowestRowPlusCol() == 1);
+
+        grid.MoveCube(grid.cubes[1], 3, 3, 0);
+        REQUIRE(grid.GetLowestRowPlusCol() == 2);
+
+        grid.MoveCube(grid.cubes[0], -2, -5, 0);
+        REQUIRE(grid.GetLowestRowPlusCol() == -7);
+    }
+
+    SECTION("Test with all the cubes set at once.")
+    {
+        std::vector<Cube> cubes;
+
+        for(int x = 0; x < 50; x++)
+        {
+            for(int y = 0; y < 50; y++)
+            {
+                cubes.push_back(Cube(49 - x, y - 20, 0, 0));
+            }
+        }
+
+        grid.SetCubes(cubes);
+        REQUIRE(grid.cubes.size() == 2500);
+        REQUIRE(grid.GetLowestRowPlusCol() == -20);
+        REQUIRE(grid.At(49, 29) == &grid.cubes[49]);
+        REQUIRE(grid.At(-3, -1) == nullptr);
+        REQUIRE(grid.GetNavGraph().GetDegree(grid.GetIndex(0, -20)) == 2);
+    }
 }
 
 TEST_CASE("Tests for GetCubeByCoord", "[Grid]")
@@ -41,10 +83,8 @@ TEST_CASE("Tests for GetCubeByCoord", "[Grid]")
     Cube *cube = nullptr;
     grid.AddCube(0, 0, 0, 0);
 
-    grid.cubes[0].dst.x = 100;
-    grid.cubes[0].dst.y = 200;
-    grid.cubes[0].dst.w = 204;
-    grid.cubes[0].dst.h = 234;
+    /* The cube (0, 0) is rendered at (100, 200) and is 204 x 234. */
+    grid.SetProjection(100, 200, 204, 234, 1);
 
     cube = grid.GetCubeByCoord(0, 0);
 
@@ -67,12 +107,8 @@ TEST_CASE("Tests for GetCubeByCoord", "[Grid]")
         REQUIRE(cube != nullptr);
     }
 
-    grid.AddCube(1, 0, 0, 0);
-
-    grid.cubes[1].dst.x = 100;
-    grid.cubes[1].dst.y = 200;
-    grid.cubes[1].dst.w = 204;
-    grid.cubes[1].dst.h = 234;
+    /* Raised so that its top part covers the top part of the cube (0, 0). */
+    grid.AddCube(1, 1, -117, 0);
 
     cube = grid.GetCubeByCoord(100 + 204 / 2, 200 + 50);
 
@@ -81,4 +117,353 @@ TEST_CASE("Tests for GetCubeByCoord", "[Grid]")
         REQUIRE(cube != nullptr);
         REQUIRE(cube->coordX == 1);
     }
+
+    SECTION("Test without projection.")
+    {
+        Grid otherGrid;
+        otherGrid.AddCube(0, 0, 0, 0);
+
+        REQUIRE(otherGrid.GetCubeByCoord(100 + 204 / 2, 200 + 50) == nullptr);
+    }
+}
+
+TEST_CASE("Tests for GetCubeByCoord with the rendered positions", "[Grid]")
+{
+    Grid grid;
+    float zoom = 1.5;
+    int width = 204 * zoom;
+    int height = 234 * zoom;
+
+    for(int x = -10; x < 30; x++)
+    {
+        for(int y = 0; y < 40; y++)
+        {
+            grid.AddCube(x, y, -10 * ((x + 2 * y) % 3), 0);
+        }
+    }
+
+    grid.SetProjection(-300, 50, width, height, zoom);
+
+    /* Same positions as Renderer::SetDstPositions. */
+    for(auto &i : grid.cubes)
+    {
+        i.dst.w = width;
+        i.dst.h = height;
+        i.dst.x = i.dst.w / 2 * (i.coordX - i.coordY) - 300;
+        i.dst.y = i.dst.h / 4 * (i.coordX + i.coordY) + 50 + i.coordZ * zoom;
+    }
+
+    SECTION("Test with the center of the top part of every cube.")
+    {
+        bool isEveryCubeFound = true;
+
+        for(auto &i : grid.cubes)
+        {
+            Cube *cube = grid.GetCubeByCoord(i.dst.x + i.dst.w / 2,
+                                             i.dst.y + i.dst.h / 4);
+
+            if(cube != &i)
+            {
+                isEveryCubeFound = false;
+            }
+        }
+
+        REQUIRE(isEveryCubeFound);
+    }
+
+    SECTION("Test near the corners of the top part of a raised cube.")
+    {
+        Cube *cube = grid.At(5, 6);
+        int centerX = cube->dst.x + cube->dst.w / 2;
+        int centerY = cube->dst.y + cube->dst.h / 4;
+
+        REQUIRE(grid.GetCubeByCoord(centerX, cube->dst.y + 5) == cube);
+        REQUIRE(grid.GetCubeByCoord(centerX - cube->dst.w / 2 + 10,
+                                    centerY) == cube);
+        REQUIRE(grid.GetCubeByCoord(centerX + cube->dst.w / 2 - 10,
+                                    centerY) == cube);
+    }
+}
+
+TEST_CASE("Tests for GetVisibleChunks", "[Grid]")
+{
+    Grid grid;
+    std::vector<int> chunkIndexes;
+    float zoom = 2;
+    int width = 204 * zoom;
+    int height = 234 * zoom;
+
+    for(int x = 0; x < 100; x++)
+    {
+        for(int y = 0; y < 100; y++)
+        {
+            grid.AddCube(x, y, -10 * ((x + y) % 4), 0);
+        }
+    }
+
+    SECTION("Test without a projection.")
+    {
+        grid.GetVisibleChunks(800, 600, chunkIndexes);
+        REQUIRE(chunkIndexes.size() == grid.GetChunks().GetChunks().size());
+    }
+
+    SECTION("Test that every cube on the screen is in a visible chunk.")
+    {
+        grid.SetProjection(-2000, -3000, width, height, zoom);
+        grid.GetVisibleChunks(800, 600, chunkIndexes);
+
+        std::vector<bool> isChunkVisible(grid.GetChunks().GetChunks().size());
+        bool isEveryCubeFound = true;
+        int nbCubesOnScreen = 0;
+
+        for(auto const &i : chunkIndexes)
+        {
+            isChunkVisible[i] = true;
+        }
+
+        /* Same positions as Renderer::SetDstPositions. */
+        for(auto const &i : grid.cubes)
+        {
+            int x = width / 2 * (i.coordX - i.coordY) - 2000;
+            int y = height / 4 * (i.coordX + i.coordY) - 3000 + i.coordZ * zoom;
+
+            if(x + width > 0 && x < 800 && y + height > 0 && y < 600)
+            {
+                nbCubesOnScreen++;
+
+                if(!isChunkVisible[grid.GetChunks().GetChunkIndex(i.coordX,
+                                                                  i.coordY)])
+                {
+                    isEveryCubeFound = false;
+                }
+            }
+        }
+
+        REQUIRE(nbCubesOnScreen > 0);
+        REQUIRE(isEveryCubeFound);
+        REQUIRE(chunkIndexes.size() < grid.GetChunks().GetChunks().size());
+    }
+
+    SECTION("Test with the grid outside of the screen.")
+    {
+        grid.SetProjection(30000, 0, width, height, zoom);
+        grid.GetVisibleChunks(800, 600, chunkIndexes);
+        REQUIRE(chunkIndexes.empty());
+    }
+}
+
+TEST_CASE("Tests for GetCubesInScreenRect", "[Grid]")
+{
+    Grid grid;
+    std::vector<int> cubeIndexes;
+    float zoom = 0.5;
+    int width = 204 * zoom;
+    int height = 234 * zoom;
+
+    for(int x = -20; x < 40; x++)
+    {
+        for(int y = -5; y < 50; y++)
+        {
+            if((x * 7 + y * 3) % 11 != 0)
+            {
+                grid.AddCube(x, y, -15 * ((x + 2 * y) % 3), 0);
+            }
+        }
+    }
+
+    SECTION("Test without a projection.")
+    {
+        grid.GetCubesInScreenRect(0, 0, 800, 600, cubeIndexes);
+        REQUIRE(cubeIndexes.empty());
+    }
+
+    SECTION("Test against every cube of the grid.")
+    {
+        grid.SetProjection(400, -500, width, height, zoom);
+
+        SDL_Rect rects[] = {{0, 0, 800, 600}, {390, 100, 30, 45},
+                            {-300, -900, 200, 100}, {0, 0, 1, 1},
+                            {-5000, -5000, 10000, 10000}};
+        bool isSameCubes = true;
+
+        for(auto const &rect : rects)
+        {
+            std::vector<int> expectedIndexes;
+
+            /* Same positions as Renderer::SetDstPositions. */
+            for(unsigned int i = 0; i < grid.cubes.size(); i++)
+            {
+                const Cube &cube = grid.cubes[i];
+                int x = width / 2 * (cube.coordX - cube.coordY) + 400;
+                int y = height / 4 * (cube.coordX + cube.coordY) - 500
+                        + cube.coordZ * zoom;
+
+                if(x + width > rect.x && x < rect.x + rect.w
+                   && y + height > rect.y && y < rect.y + rect.h)
+                {
+                    expectedIndexes.push_back(i);
+                }
+            }
+
+            grid.GetCubesInScreenRect(rect.x, rect.y, rect.w, rect.h,
+                                      cubeIndexes);
+            std::sort(cubeIndexes.begin(), cubeIndexes.end());
+
+            if(cubeIndexes != expectedIndexes)
+            {
+                isSameCubes = false;
+            }
+        }
+
+        REQUIRE(isSameCubes);
+    }
+}
+
+TEST_CASE("Tests for At", "[Grid]")
+{
+    Grid grid;
+    grid.AddCube(0, 0, 0, 0);
+    grid.AddCube(3, -2, 0, 0);
+
+    SECTION("Test with existing cubes.")
+    {
+        REQUIRE(grid.At(0, 0) == &grid.cubes[0]);
+        REQUIRE(grid.At(3, -2) == &grid.cubes[1]);
+        REQUIRE(grid.GetIndex(3, -2) == 1);
+    }
+
+    SECTION("Test with coordinates without a cube.")
+    {
+        REQUIRE(grid.At(1, 0) == nullptr);
+        REQUIRE(grid.At(-10, 20) == nullptr);
+        REQUIRE(grid.GetIndex(1, 0) == -1);
+    }
+
+    SECTION("Test with a cube added outside of the index bounds.")
+    {
+        grid.AddCube(-20, 15, 0, 0);
+        REQUIRE(grid.At(-20, 15) == &grid.cubes[2]);
+        REQUIRE(grid.At(3, -2) == &grid.cubes[1]);
+    }
+
+    SECTION("Test with a moved cube.")
+    {
+        grid.MoveCube(grid.cubes[1], 5, 5, 0);
+        REQUIRE(grid.At(3, -2) == nullptr);
+        REQUIRE(grid.At(5, 5) == &grid.cubes[1]);
+    }
+
+    SECTION("Test after modifying the cubes vector directly.")
+    {
+        grid.cubes.push_back(Cube(7, 7, 0, 0));
+        grid.BuildIndex();
+        REQUIRE(grid.At(7, 7) == &grid.cubes[2]);
+        REQUIRE(grid.At(0, 0) == &grid.cubes[0]);
+    }
+}
+
+TEST_CASE("Tests for GetPosition and IsWall", "[Grid]")
+{
+    Grid grid;
+    grid.AddCube(0, 0, 0, 0);
+    grid.AddCube(3, -2, 0, 0);
+
+    SECTION("Test with added cubes.")
+    {
+        REQUIRE(grid.GetPosition(1).x == 3);
+        REQUIRE(grid.GetPosition(1).y == -2);
+        REQUIRE(!grid.IsWall(0));
+    }
+
+    SECTION("Test with a wall.")
+    {
+        grid.SetWall(3, -2, true);
+        REQUIRE(grid.IsWall(1));
+        REQUIRE(!grid.IsWall(0));
+
+        grid.SetWall(3, -2, false);
+        REQUIRE(!grid.IsWall(1));
+    }
+
+    SECTION("Test with a moved cube.")
+    {
+        grid.MoveCube(grid.cubes[0], 5, 6, 0);
+        REQUIRE(grid.GetPosition(0).x == 5);
+        REQUIRE(grid.GetPosition(0).y == 6);
+    }
+
+    SECTION("Test after modifying the cubes vector directly.")
+    {
+        grid.cubes.push_back(Cube(7, 8, 0, 0, true));
+        grid.BuildIndex();
+        REQUIRE(grid.GetPosition(2).x == 7);
+        REQUIRE(grid.GetPosition(2).y == 8);
+        REQUIRE(grid.IsWall(2));
+    }
+}
+
+TEST_CASE("Tests for GetVersion", "[Grid]")
+{
+    Grid grid;
+    Grid otherGrid;
+    std::vector<int> cubeIndexes;
+
+    /* Both grids are built the same way. */
+    for(Grid *i : {&grid, &otherGrid})
+    {
+        i->AddCube(0, 0, 0, 0);
+        i->AddCube(1, 0, 0, 0);
+    }
+
+    SECTION("Test that two grids never have the same version.")
+    {
+        REQUIRE(grid.GetVersion() != otherGrid.GetVersion());
+
+        grid.SetWall(1, 0, true);
+        otherGrid.SetWall(1, 0, true);
+        REQUIRE(grid.GetVersion() != otherGrid.GetVersion());
+    }
+
+    SECTION("Test GetWallChangesSince with the versions of a grid.")
+    {
+        unsigned int version = grid.GetVersion();
+
+        grid.SetWall(1, 0, true);
+        REQUIRE(grid.GetWallChangesSince(version, cubeIndexes));
+        REQUIRE(cubeIndexes == std::vector<int>{1});
+
+        version = grid.GetVersion();
+        grid.SetWall(0, 0, true);
+        REQUIRE(grid.GetWallChangesSince(version, cubeIndexes));
+        REQUIRE(cubeIndexes == std::vector<int>{0});
+    }
+
+    SECTION("Test that only added or moved cubes change the terrain.")
+    {
+        unsigned int terrainVersion = grid.GetTerrainVersion();
+
+        grid.SetWall(1, 0, true);
+        grid.SetWall(1, 0, false);
+        REQUIRE(grid.GetTerrainVersion() == terrainVersion);
+        REQUIRE(grid.GetVersion() != terrainVersion);
+
+        grid.MoveCube(grid.cubes[1], 2, 0, 0);
+        REQUIRE(grid.GetTerrainVersion() != terrainVersion);
+        REQUIRE(grid.GetTerrainVersion() == grid.GetVersion());
+
+        terrainVersion = grid.GetTerrainVersion();
+        grid.AddCube(3, 0, 0, 0);
+        REQUIRE(grid.GetTerrainVersion() != terrainVersion);
+    }
+
+    SECTION("Test GetWallChangesSince with the version of another grid.")
+    {
+        grid.SetWall(1, 0, true);
+        unsigned int version = grid.GetVersion();
+
+        otherGrid.SetWall(0, 0, true);
+        otherGrid.SetWall(0, 0, false);
+        REQUIRE(version < otherGrid.GetVersion());
+        REQUIRE_FALSE(otherGrid.GetWallChangesSince(version, cubeIndexes));
+    }
 }
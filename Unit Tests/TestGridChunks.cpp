@@ -0,0 +1,118 @@
+/*
+ * Tested class: GridChunks
+ *
+ * This file unit tests the scenarios for the methods in the GridChunks class,
+ * through the chunks kept by a Grid.
+ */
+
+#include "../~External Libraries/catch.hpp"
+#include "../Level/Grid.h"
+
+/**
+ * @brief Checks that every cube is in exactly one chunk, the one containing
+ *        its coordinates, and inside of the bounds of this chunk.
+ *
+ * @param grid: Grid to check.
+ *
+ * @return True if the chunks match the cubes.
+ */
+static bool IsEveryCubeInItsChunk(const Grid &grid)
+{
+    const std::vector<GridChunk> &chunks = grid.GetChunks().GetChunks();
+    unsigned int nbCubes = 0;
+
+    for(auto const &chunk : chunks)
+    {
+        for(auto const &i : chunk.cubeIndexes)
+        {
+            const Cube &cube = grid.cubes[i];
+
+            if(&chunks[grid.GetChunks().GetChunkIndex(cube.coordX,
+                                                      cube.coordY)] != &chunk
+               || cube.coordX < chunk.minX || cube.coordX > chunk.maxX
+               || cube.coordY < chunk.minY || cube.coordY > chunk.maxY
+               || cube.coordZ < chunk.minZ || cube.coordZ > chunk.maxZ)
+            {
+                return false;
+            }
+        }
+
+        nbCubes += chunk.cubeIndexes.size();
+    }
+
+    return nbCubes == grid.cubes.size();
+}
+
+TEST_CASE("Tests for GridChunks", "[GridChunks]")
+{
+    Grid grid;
+    std::vector<int> chunkIndexes;
+
+    for(int x = -40; x < 60; x++)
+    {
+        for(int y = 0; y < 70; y++)
+        {
+            grid.AddCube(x, y, (x + y) % 5, 0);
+        }
+    }
+
+    const GridChunks &chunks = grid.GetChunks();
+
+    SECTION("Test the chunks of added cubes")
+    {
+        /* From -64 to 63 in x and from 0 to 95 in y. */
+        REQUIRE(chunks.GetChunks().size() == 4 * 3);
+        REQUIRE(IsEveryCubeInItsChunk(grid));
+        REQUIRE(chunks.GetChunkIndex(-1, 0) != chunks.GetChunkIndex(0, 0));
+        REQUIRE(chunks.GetChunkIndex(-32, 0) == chunks.GetChunkIndex(-1, 31));
+        REQUIRE(chunks.GetChunkIndex(0, 100) == -1);
+
+        const GridChunk &chunk = chunks.GetChunks()[chunks.GetChunkIndex(-40,
+                                                                         64)];
+        REQUIRE(chunk.minX == -40);
+        REQUIRE(chunk.maxX == -33);
+        REQUIRE(chunk.minY == 64);
+        REQUIRE(chunk.maxY == 69);
+    }
+
+    SECTION("Test the chunks inside of a rectangle")
+    {
+        chunks.GetChunksInRect(0, 0, 10, 10, chunkIndexes);
+        REQUIRE(chunkIndexes.size() == 1);
+        REQUIRE(chunkIndexes[0] == chunks.GetChunkIndex(5, 5));
+
+        chunks.GetChunksInRect(-33, 31, 32, 32, chunkIndexes);
+        REQUIRE(chunkIndexes.size() == 4 * 2);
+
+        chunks.GetChunksInRect(60, 0, 100, 100, chunkIndexes);
+        REQUIRE(chunkIndexes.empty());
+    }
+
+    SECTION("Test with moved cubes")
+    {
+        grid.MoveCube(grid.cubes[0], 200, -5, 10);
+        REQUIRE(IsEveryCubeInItsChunk(grid));
+        REQUIRE(chunks.GetChunks()[chunks.GetChunkIndex(200, -5)].maxZ == 10);
+
+        REQUIRE(chunks.GetChunks()[chunks.GetChunkIndex(-39, 0)].minX
+                == -40);
+
+        /* Move the other cubes of the chunk in x = -40. */
+        for(int y = 1; y < 32; y++)
+        {
+            grid.MoveCube(*grid.At(-40, y), 100, y, 0);
+        }
+
+        REQUIRE(IsEveryCubeInItsChunk(grid));
+        REQUIRE(chunks.GetChunks()[chunks.GetChunkIndex(-39, 0)].minX
+                == -39);
+    }
+
+    SECTION("Test after modifying the cubes vector directly")
+    {
+        grid.cubes.push_back(Cube(-100, -100, 0, 0));
+        grid.BuildIndex();
+        REQUIRE(IsEveryCubeInItsChunk(grid));
+        REQUIRE(chunks.GetChunkIndex(-100, -100) >= 0);
+    }
+}
@@ -0,0 +1,162 @@
+/*
+ * Tested class: HierarchicalPath
+ *
+ * This file unit tests the scenarios for the methods in the HierarchicalPath
+ * class, comparing its paths with the ones of the pathfinder.
+ */
+
+#include <cstdlib>
+#include "../~External Libraries/catch.hpp"
+#include "../Level/HierarchicalPath.h"
+#include "../Level/Path.h"
+
+/**
+ * @brief Follows directions from a starting point and checks that every step
+ *        is on a walkable cube and that the path ends at the ending point.
+ *
+ * @return True if the directions are a valid path.
+ */
+static bool IsPathValid(const Grid &grid, int x, int y, int endX, int endY,
+                        const std::vector<int> &directions)
+{
+    for(auto const &i : directions)
+    {
+        x += (i == DIRECTION_RIGHT) - (i == DIRECTION_LEFT);
+        y += (i == DIRECTION_DOWN) - (i == DIRECTION_UP);
+
+        const Cube *cube = grid.At(x, y);
+
+        if(cube == nullptr || cube->IsWall())
+        {
+            return false;
+        }
+    }
+
+    return x == endX && y == endY;
+}
+
+TEST_CASE("Tests for FindPathHierarchical", "[HierarchicalPath]")
+{
+    Grid grid;
+    Path path;
+    Path hierarchicalPath;
+
+    /* Setting up a 70x50 grid (partial clusters on the right and bottom). */
+    for(int x = 0; x < 70; x++)
+    {
+        for(int y = 0; y < 50; y++)
+        {
+            grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    SECTION("Test with invalid starting and ending points")
+    {
+        REQUIRE(hierarchicalPath.FindPathHierarchical(0, 0, 0, 0, grid)
+                == false);
+        REQUIRE(hierarchicalPath.FindPathHierarchical(-5, -5, 0, 0, grid)
+                == false);
+        REQUIRE(hierarchicalPath.FindPathHierarchical(0, 0, -5, -5, grid)
+                == false);
+        REQUIRE(hierarchicalPath.GetDirections().size() == 0);
+    }
+
+    SECTION("Test on an open grid")
+    {
+        REQUIRE(hierarchicalPath.FindPathHierarchical(0, 0, 69, 49, grid));
+        REQUIRE(hierarchicalPath.GetDirections().size() == 118);
+        REQUIRE(IsPathValid(grid, 0, 0, 69, 49,
+                            hierarchicalPath.GetDirections().ToVector()));
+    }
+
+    SECTION("Test with random walls against FindPath")
+    {
+        srand(5);
+
+        for(int x = 0; x < 70; x++)
+        {
+            for(int y = 0; y < 50; y++)
+            {
+                grid.SetWall(x, y, rand() % 100 < 30);
+            }
+        }
+
+        for(int i = 0; i < 200; i++)
+        {
+            int startX = rand() % 70;
+            int startY = rand() % 50;
+            int endX = rand() % 70;
+            int endY = rand() % 50;
+
+            /* Change walls between searches, so that clusters are updated. */
+            if(i % 5 == 0)
+            {
+                grid.SetWall(rand() % 70, rand() % 50, rand() % 2 == 0);
+            }
+
+            bool isFound = path.FindPath(startX, startY, endX, endY, grid);
+
+            REQUIRE(hierarchicalPath.FindPathHierarchical(startX, startY,
+                                                          endX, endY, grid)
+                    == isFound);
+
+            if(isFound)
+            {
+                REQUIRE(hierarchicalPath.GetDirections().size()
+                        >= path.GetDirections().size());
+                REQUIRE(IsPathValid(grid, startX, startY, endX, endY,
+                                    hierarchicalPath.GetDirections().ToVector()));
+            }
+        }
+    }
+}
+
+TEST_CASE("Tests for HierarchicalPath updates", "[HierarchicalPath]")
+{
+    Grid grid;
+    HierarchicalPath hierarchy;
+    std::vector<int> directions;
+
+    /* Setting up an open 64x64 grid (4x4 clusters). */
+    for(int x = 0; x < 64; x++)
+    {
+        for(int y = 0; y < 64; y++)
+        {
+            grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    hierarchy.Update(grid);
+    int nbRebuilt = hierarchy.GetNbRebuiltClusters();
+
+    REQUIRE(nbRebuilt == 16);
+    REQUIRE(hierarchy.GetNbNodes() > 0);
+
+    SECTION("Test that a wall inside of a cluster rebuilds only its cluster")
+    {
+        grid.SetWall(5, 5, true);
+        REQUIRE(hierarchy.FindPath(0, 0, 63, 63, grid, directions));
+        REQUIRE(hierarchy.GetNbRebuiltClusters() == nbRebuilt + 1);
+    }
+
+    SECTION("Test that a wall on a border rebuilds at most two clusters")
+    {
+        grid.SetWall(15, 5, true);
+        hierarchy.Update(grid);
+        REQUIRE(hierarchy.GetNbRebuiltClusters() <= nbRebuilt + 2);
+    }
+
+    SECTION("Test that a wall cutting a border is taken into account")
+    {
+        for(int y = 0; y < 64; y++)
+        {
+            grid.SetWall(31, y, y != 63);
+        }
+
+        REQUIRE(hierarchy.FindPath(0, 0, 63, 0, grid, directions));
+        REQUIRE(directions.size() == 63 + 2 * 63);
+
+        grid.SetWall(31, 63, true);
+        REQUIRE(hierarchy.FindPath(0, 0, 63, 0, grid, directions) == false);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Tested class: NavGraph
+ *
+ * This file unit tests the scenarios for the methods in the NavGraph class,
+ * through the navigation graph kept by a Grid.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include "../~External Libraries/catch.hpp"
+#include "../Level/Grid.h"
+
+/**
+ * @brief Checks that the navigation graph of a grid contains exactly the
+ *        adjacent cubes found with the coordinate index, the walkable ones
+ *        first.
+ *
+ * @param grid: Grid to check.
+ *
+ * @return True if the graph matches the grid.
+ */
+static bool IsNavGraphValid(const Grid &grid)
+{
+    const NavGraph &navGraph = grid.GetNavGraph();
+
+    if(navGraph.GetNbNodes() != static_cast<int>(grid.cubes.size()))
+    {
+        return false;
+    }
+
+    for(unsigned int i = 0; i < grid.cubes.size(); i++)
+    {
+        const int *neighbours = navGraph.GetNeighbours(i);
+        const signed char *directions = navGraph.GetDirections(i);
+        int nbNeighbours = 0;
+
+        for(int direction = DIRECTION_LEFT; direction <= DIRECTION_DOWN;
+            direction++)
+        {
+            int neighbour = grid.GetAdjacentIndex(grid.cubes[i], direction);
+
+            if(neighbour < 0)
+            {
+                continue;
+            }
+
+            nbNeighbours++;
+
+            const int *slot = std::find(neighbours,
+                                        neighbours
+                                        + navGraph.GetNbNeighbours(i),
+                                        neighbour);
+            int k = slot - neighbours;
+
+            if(k == navGraph.GetNbNeighbours(i) || directions[k] != direction
+               || (k < navGraph.GetDegree(i)) == grid.cubes[neighbour].IsWall())
+            {
+                return false;
+            }
+        }
+
+        if(nbNeighbours != navGraph.GetNbNeighbours(i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TEST_CASE("Tests for NavGraph", "[NavGraph]")
+{
+    Grid grid;
+
+    /* 4 x 3 grid with a hole in (0, 2). */
+    for(int x = 0; x < 3; x++)
+    {
+        for(int y = 0; y < 4; y++)
+        {
+            if(x != 0 || y != 2)
+            {
+                grid.AddCube(x, y, 0, 0);
+            }
+        }
+    }
+
+    const NavGraph &navGraph = grid.GetNavGraph();
+    int corner = grid.GetIndex(0, 0);
+    int center = grid.GetIndex(1, 1);
+
+    SECTION("Test the neighbours of the cubes")
+    {
+        REQUIRE(IsNavGraphValid(grid));
+        REQUIRE(navGraph.GetDegree(corner) == 2);
+        REQUIRE(navGraph.GetDegree(center) == 4);
+        REQUIRE(navGraph.GetNbNeighbours(grid.GetIndex(0, 3)) == 1);
+    }
+
+    SECTION("Test that walls are moved out of the walkable neighbours")
+    {
+        grid.SetWall(1, 0, true);
+        REQUIRE(navGraph.GetDegree(corner) == 1);
+        REQUIRE(navGraph.GetNbNeighbours(corner) == 2);
+        REQUIRE(navGraph.GetNeighbours(corner)[0] == grid.GetIndex(0, 1));
+        REQUIRE(navGraph.GetDegree(center) == 3);
+
+        grid.SetWall(1, 0, false);
+        REQUIRE(navGraph.GetDegree(corner) == 2);
+        REQUIRE(navGraph.GetDegree(center) == 4);
+        REQUIRE(IsNavGraphValid(grid));
+    }
+
+    SECTION("Test random wall changes")
+    {
+        srand(7);
+
+        for(int i = 0; i < 200; i++)
+        {
+            grid.SetWall(rand() % 3, rand() % 4, rand() % 2 == 0);
+        }
+
+        REQUIRE(IsNavGraphValid(grid));
+    }
+
+    SECTION("Test after moving a cube and modifying the cubes directly")
+    {
+        grid.SetWall(2, 2, true);
+        grid.MoveCube(grid.cubes[grid.GetIndex(0, 3)], 0, 2, 0);
+        REQUIRE(IsNavGraphValid(grid));
+
+        grid.cubes.push_back(Cube(3, 0, 0, 0, true));
+        grid.BuildIndex();
+        REQUIRE(IsNavGraphValid(grid));
+        REQUIRE(navGraph.GetNbNeighbours(grid.GetIndex(3, 0)) == 1);
+        REQUIRE(navGraph.GetDegree(grid.GetIndex(2, 0)) == 2);
+    }
+}
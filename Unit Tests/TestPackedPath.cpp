@@ -0,0 +1,100 @@
+/*
+ * Tested class: PackedPath
+ *
+ * This file unit tests the scenarios for the methods in the PackedPath and
+ * PathView classes.
+ */
+
+#include <memory>
+#include <stdexcept>
+#include "../~External Libraries/catch.hpp"
+#include "../Level/PackedPath.h"
+#include "../Level/Path.h"
+
+TEST_CASE("Tests for PackedPath", "[PackedPath]")
+{
+    std::vector<int> directions;
+
+    /* 13 directions, so that the last byte is partially used. */
+    for(int i = 0; i < 13; i++)
+    {
+        directions.push_back((i * 7) % 4);
+    }
+
+    auto packedPath = std::make_shared<const PackedPath>(directions);
+
+    SECTION("Test that directions are unpacked as they were packed")
+    {
+        REQUIRE(packedPath->size() == 13);
+
+        for(unsigned int i = 0; i < directions.size(); i++)
+        {
+            REQUIRE((*packedPath)[i] == directions[i]);
+        }
+    }
+
+    SECTION("Test views starting at different steps")
+    {
+        PathView view(packedPath, 0);
+        PathView walkedView(packedPath, 10);
+
+        REQUIRE(view.ToVector() == directions);
+        REQUIRE(walkedView.size() == 3);
+        REQUIRE(walkedView.at(0) == directions[10]);
+        REQUIRE(walkedView.at(2) == directions[12]);
+        REQUIRE_THROWS_AS(walkedView.at(3), std::out_of_range);
+        REQUIRE(PathView(packedPath, 13).empty());
+    }
+
+    SECTION("Test empty views")
+    {
+        PathView view;
+
+        REQUIRE(view.size() == 0);
+        REQUIRE(view.empty());
+        REQUIRE(view == PathView(packedPath, 20));
+        REQUIRE(view != PathView(packedPath, 0));
+    }
+
+    SECTION("Test comparison of views of different paths")
+    {
+        auto copy = std::make_shared<const PackedPath>(directions);
+
+        REQUIRE(PathView(packedPath, 4) == PathView(copy, 4));
+        REQUIRE(PathView(packedPath, 4) != PathView(copy, 5));
+    }
+}
+
+TEST_CASE("Tests for Advance", "[Pathfinder]")
+{
+    Path path;
+
+    path.SetDirections({DIRECTION_RIGHT, DIRECTION_DOWN, DIRECTION_LEFT});
+
+    SECTION("Test that copies share the path but walk it separately")
+    {
+        Path copy = path;
+
+        copy.Advance();
+        REQUIRE(copy.GetDirections().size() == 2);
+        REQUIRE(copy.GetDirections().at(0) == DIRECTION_DOWN);
+        REQUIRE(path.GetDirections().size() == 3);
+        REQUIRE(path.GetDirections().at(0) == DIRECTION_RIGHT);
+    }
+
+    SECTION("Test advancing past the end of the path")
+    {
+        for(int i = 0; i < 5; i++)
+        {
+            path.Advance();
+        }
+
+        REQUIRE(path.GetDirections().size() == 0);
+    }
+
+    SECTION("Test setting an empty path")
+    {
+        path.SetDirections({});
+        REQUIRE(path.GetDirections().empty());
+    }
+}
@@ -10,6 +10,7 @@
 #include <vector>
 #include "../~External Libraries/catch.hpp"
 #include "../Level/Path.h"
+#include "../Level/ThreadPool.h"
 #include "../Entities/Unit.h"
 
 TEST_CASE("Tests for CreatePath", "[Pathfinder]")
@@ -33,10 +34,8 @@ TEST_CASE("Tests for CreatePath", "[Pathfinder]")
     Cube tempCube(0, 0, 0, 0);
     cubes.push_back(tempCube);
     tempCube.coordX++;
-    tempCube.isWall = true;
-    cubes.push_back(tempCube);
+    cubes.push_back(Cube(tempCube.coordX, tempCube.coordY, 0, 0, true));
     tempCube.coordX++;
-    tempCube.isWall = false;
     cubes.push_back(tempCube);
     tempCube.coordX = 0;
     tempCube.coordY = 1;
@@ -51,10 +50,8 @@ TEST_CASE("Tests for CreatePath", "[Pathfinder]")
     /* Setting up 2nd collumn. */
     tempCube.coordX = 1;
     tempCube.coordY = 2;
-    tempCube.isWall = true;
-    cubes.push_back(tempCube);
+    cubes.push_back(Cube(tempCube.coordX, tempCube.coordY, 0, 0, true));
     tempCube.coordX++;
-    tempCube.isWall = false;
     cubes.push_back(tempCube);
 
     /* Setting up 1st collumn. */
@@ -158,3 +155,219 @@ TEST_CASE("Tests for DeletePath", "[Pathfinder]")
         REQUIRE(unit.path.GetDirections().size() == 0);
     }
 }
+
+TEST_CASE("Tests for FindPathIncremental", "[Pathfinder]")
+{
+    Grid grid;
+    Path path;
+    Path incrementalPath;
+
+    /* Setting up an open 12x12 grid. */
+    for(int x = 0; x < 12; x++)
+    {
+        for(int y = 0; y < 12; y++)
+        {
+            grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    SECTION("Test with invalid starting and ending points")
+    {
+        REQUIRE(incrementalPath.FindPathIncremental(0, 0, 0, 0, grid)
+                == false);
+        REQUIRE(incrementalPath.FindPathIncremental(-5, -5, 0, 0, grid)
+                == false);
+        REQUIRE(incrementalPath.FindPathIncremental(0, 0, -5, -5, grid)
+                == false);
+        REQUIRE(incrementalPath.GetDirections().size() == 0);
+    }
+
+    SECTION("Test with walls placed and removed between searches")
+    {
+        /* Walls placed one by one, forming a wall with a moving gap. */
+        for(int i = 0; i < 12; i++)
+        {
+            grid.SetWall(6, i, true);
+
+            if(i > 0)
+            {
+                grid.SetWall(6, i - 1, false);
+            }
+
+            bool isFound = path.FindPath(0, i, 11, 11 - i, grid);
+
+            REQUIRE(incrementalPath.FindPathIncremental(0, i, 11, 11 - i, grid)
+                    == isFound);
+            REQUIRE(incrementalPath.GetDirections().size()
+                    == path.GetDirections().size());
+        }
+    }
+
+    SECTION("Test with the destination being cut off")
+    {
+        REQUIRE(incrementalPath.FindPathIncremental(0, 0, 11, 11, grid));
+        REQUIRE(incrementalPath.GetDirections().size() == 22);
+
+        grid.SetWall(10, 11, true);
+        grid.SetWall(11, 10, true);
+        REQUIRE(incrementalPath.FindPathIncremental(0, 0, 11, 11, grid)
+                == false);
+        REQUIRE(incrementalPath.GetDirections().size() == 0);
+
+        grid.SetWall(11, 10, false);
+        REQUIRE(incrementalPath.FindPathIncremental(1, 0, 11, 11, grid));
+        REQUIRE(incrementalPath.GetDirections().size() == 21);
+    }
+
+    SECTION("Test that copies do not share the planner")
+    {
+        REQUIRE(incrementalPath.FindPathIncremental(0, 0, 11, 11, grid));
+
+        Path copiedPath = incrementalPath;
+        std::vector<Path> paths(3, incrementalPath);
+
+        /* Every copy searches from another start between wall changes. */
+        for(int i = 0; i < 12; i++)
+        {
+            grid.SetWall(6, i, i % 3 != 0);
+
+            for(unsigned int j = 0; j < paths.size(); j++)
+            {
+                bool isFound = path.FindPath(j, 0, 11, 11, grid);
+
+                REQUIRE(paths[j].FindPathIncremental(j, 0, 11, 11, grid)
+                        == isFound);
+                REQUIRE(paths[j].GetDirections().size()
+                        == path.GetDirections().size());
+            }
+
+            bool isFound = path.FindPath(0, 11, 11, 11, grid);
+
+            REQUIRE(copiedPath.FindPathIncremental(0, 11, 11, 11, grid)
+                    == isFound);
+            REQUIRE(copiedPath.GetDirections().size()
+                    == path.GetDirections().size());
+        }
+
+        /* The original still repairs its own search state. */
+        bool isFound = path.FindPath(0, 0, 11, 11, grid);
+
+        REQUIRE(incrementalPath.FindPathIncremental(0, 0, 11, 11, grid)
+                == isFound);
+        REQUIRE(incrementalPath.GetDirections().size()
+                == path.GetDirections().size());
+    }
+}
+
+TEST_CASE("Tests for FindPaths", "[Pathfinder]")
+{
+    Grid grid;
+    Path path;
+    std::vector<PathQuery> queries;
+    std::vector<Path> paths;
+
+    /*
+     * Setting up a 20x20 grid with walls on every odd column, except for one
+     * opening alternating between the top and the bottom.
+     */
+    for(int x = 0; x < 20; x++)
+    {
+        for(int y = 0; y < 20; y++)
+        {
+            grid.AddCube(x, y, 0, 0);
+            grid.SetWall(x, y, x % 2 == 1 && y != (x % 4 == 1 ? 0 : 19));
+        }
+    }
+
+    /* Setting up queries, some of them without a path. */
+    for(int i = 0; i < 100; i++)
+    {
+        queries.push_back({(i * 7) % 20, (i * 3) % 20,
+                           (i * 11) % 20, (i * 13) % 20});
+    }
+
+    queries.push_back({-1, -1, 0, 0});
+    queries.push_back({0, 0, 1, 5});
+
+    SECTION("Test that results do not depend on the number of threads")
+    {
+        for(int nbThreads : {1, 2, 4})
+        {
+            ThreadPool pool(nbThreads);
+            int nbPathsFound = Path::FindPaths(queries, grid, paths, pool);
+            int nbExpected = 0;
+
+            REQUIRE(pool.GetNbThreads() == nbThreads);
+            REQUIRE(paths.size() == queries.size());
+
+            for(unsigned int i = 0; i < queries.size(); i++)
+            {
+                bool isFound = path.FindPath(queries[i].startingPointX,
+                                             queries[i].startingPointY,
+                                             queries[i].endingPointX,
+                                             queries[i].endingPointY, grid);
+                nbExpected += isFound;
+
+                REQUIRE(paths[i].GetDirections() == path.GetDirections());
+            }
+
+            REQUIRE(nbPathsFound == nbExpected);
+        }
+    }
+
+    SECTION("Test with an empty batch")
+    {
+        queries.clear();
+        REQUIRE(Path::FindPaths(queries, grid, paths) == 0);
+        REQUIRE(paths.size() == 0);
+    }
+}
+
+TEST_CASE("Tests for GetStats", "[Pathfinder]")
+{
+    Grid grid;
+    Path path;
+
+    /* Setting up a 5x5 grid without walls. */
+    for(int x = 0; x < 5; x++)
+    {
+        for(int y = 0; y < 5; y++)
+        {
+            grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    PathFrameStats::EndFrame();
+    path.FindPath(0, 0, 4, 0, grid);
+
+#ifdef PATH_STATS
+    SECTION("Test the statistics of a straight path")
+    {
+        /* The 5 cubes of the path are expanded. */
+        REQUIRE(path.GetStats().nbSearches == 1);
+        REQUIRE(path.GetStats().nbExpandedNodes == 5);
+        REQUIRE(path.GetStats().nbRelaxedNeighbours >= 4);
+        REQUIRE(path.GetStats().openSetPeak > 0);
+        REQUIRE(path.GetStats().time > 0);
+    }
+
+    SECTION("Test the statistics of a frame")
+    {
+        path.FindPath(0, 0, 4, 4, grid);
+        REQUIRE(PathFrameStats::GetCurrentFrame().nbSearches == 2);
+        REQUIRE(PathFrameStats::GetCurrentFrame().nbExpandedNodes
+                == 5 + path.GetStats().nbExpandedNodes);
+
+        PathFrameStats::EndFrame();
+        REQUIRE(PathFrameStats::GetLastFrame().nbSearches == 2);
+        REQUIRE(PathFrameStats::GetCurrentFrame().nbSearches == 0);
+    }
+#else
+    SECTION("Test that nothing is counted without PATH_STATS")
+    {
+        REQUIRE(path.GetStats().nbSearches == 0);
+        REQUIRE(path.GetStats().nbExpandedNodes == 0);
+        REQUIRE(PathFrameStats::GetCurrentFrame().nbSearches == 0);
+    }
+#endif
+}
@@ -0,0 +1,116 @@
+/*
+ * Tested class: PathCache
+ *
+ * This file unit tests the scenarios for the methods in the PathCache class.
+ */
+
+#include "../~External Libraries/catch.hpp"
+#include "../Level/PathCache.h"
+
+TEST_CASE("Tests for PathCache", "[PathCache]")
+{
+    Grid grid;
+    PathCache pathCache;
+    Path path;
+    Path otherPath;
+
+    /*
+     * Grid setup:
+     * o oo
+     * oxox
+     * oooo
+     */
+    for(int x = 0; x < 3; x++)
+    {
+        for(int y = 0; y < 4; y++)
+        {
+            if(x != 0 || y != 2)
+            {
+                grid.AddCube(x, y, 0, 0);
+            }
+        }
+    }
+
+    grid.SetWall(1, 0, true);
+    grid.SetWall(1, 2, true);
+
+    SECTION("Test that the same path is searched only once")
+    {
+        REQUIRE(pathCache.FindPath(0, 0, 0, 3, grid, path) == true);
+        REQUIRE(pathCache.GetNbMisses() == 1);
+        REQUIRE(pathCache.GetNbHits() == 0);
+
+        REQUIRE(pathCache.FindPath(0, 0, 0, 3, grid, otherPath) == true);
+        REQUIRE(pathCache.GetNbMisses() == 1);
+        REQUIRE(pathCache.GetNbHits() == 1);
+
+        /* Both paths share the same directions. */
+        REQUIRE(path.GetPackedPath() == otherPath.GetPackedPath());
+
+        Path searchedPath;
+        searchedPath.FindPath(0, 0, 0, 3, grid);
+        REQUIRE(otherPath.GetDirections() == searchedPath.GetDirections());
+    }
+
+    SECTION("Test that paths that do not exist are cached")
+    {
+        REQUIRE(pathCache.FindPath(0, 0, 1, 0, grid, path) == false);
+        REQUIRE(pathCache.FindPath(0, 0, 1, 0, grid, path) == false);
+        REQUIRE(path.GetDirections().size() == 0);
+        REQUIRE(pathCache.GetNbHits() == 1);
+        REQUIRE(pathCache.TestPath(0, 0, 1, 0, grid) == false);
+        REQUIRE(pathCache.GetNbHits() == 2);
+    }
+
+    SECTION("Test TestPath with known and unknown paths")
+    {
+        REQUIRE(pathCache.TestPath(2, 3, 0, 3, grid) == true);
+        REQUIRE(pathCache.GetNbMisses() == 1);
+        REQUIRE(pathCache.TestPath(0, 0, 0, 2, grid) == false);
+        REQUIRE(pathCache.GetNbMisses() == 2);
+
+        pathCache.FindPath(2, 3, 0, 3, grid, path);
+        REQUIRE(pathCache.TestPath(2, 3, 0, 3, grid) == true);
+        REQUIRE(pathCache.GetNbHits() == 1);
+    }
+
+    SECTION("Test that the paths are forgotten when the grid changes")
+    {
+        pathCache.FindPath(0, 0, 0, 3, grid, path);
+        REQUIRE(pathCache.GetNbPaths() == 1);
+
+        /* Closes the only path. */
+        grid.SetWall(2, 1, true);
+
+        REQUIRE(pathCache.FindPath(0, 0, 0, 3, grid, path) == false);
+        REQUIRE(pathCache.GetNbMisses() == 2);
+        REQUIRE(pathCache.TestPath(0, 0, 0, 3, grid) == false);
+
+        grid.SetWall(2, 1, false);
+
+        REQUIRE(pathCache.TestPath(0, 0, 0, 3, grid) == true);
+        REQUIRE(pathCache.FindPath(0, 0, 0, 3, grid, path) == true);
+        REQUIRE(pathCache.GetNbPaths() == 1);
+    }
+
+    SECTION("Test Lookup, Store and the counters")
+    {
+        REQUIRE(pathCache.Lookup(0, 0, 0, 3, grid, path) == false);
+
+        otherPath.FindPath(0, 0, 0, 3, grid);
+        pathCache.Store(0, 0, 0, 3, grid, otherPath);
+
+        REQUIRE(pathCache.Lookup(0, 0, 0, 3, grid, path) == true);
+        REQUIRE(path.GetDirections() == otherPath.GetDirections());
+        REQUIRE(pathCache.GetNbHits() == 1);
+        REQUIRE(pathCache.GetNbMisses() == 1);
+
+        pathCache.ResetCounters();
+        REQUIRE(pathCache.GetNbHits() == 0);
+        REQUIRE(pathCache.GetNbMisses() == 0);
+
+        pathCache.Clear();
+        REQUIRE(pathCache.GetNbPaths() == 0);
+        REQUIRE(pathCache.Lookup(0, 0, 0, 3, grid, path) == false);
+    }
+}
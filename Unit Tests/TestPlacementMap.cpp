@@ -0,0 +1,251 @@
+/*
+ * Tested class: PlacementMap
+ *
+ * This file unit tests the scenarios for the methods in the PlacementMap
+ * class, comparing its answers with the ones of the pathfinder.
+ */
+
+#include <cstdlib>
+#include "../~External Libraries/catch.hpp"
+#include "../Level/Level.h"
+#include "../Level/Path.h"
+
+TEST_CASE("Tests for PlacementMap", "[PlacementMap]")
+{
+    Grid grid;
+    PlacementMap placementMap;
+
+    /*
+     * o represents walkable areas.
+     * x represents walls.
+     * S is the spawn point, D the destination.
+     *
+     * Grid setup:
+     * Soooo
+     * oxxxo
+     * ooooo
+     * xxoxD
+     */
+    for(int y = 0; y < 4; y++)
+    {
+        for(int x = 0; x < 5; x++)
+        {
+            grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    int walls[6][2] = {{1, 1}, {2, 1}, {3, 1}, {0, 3}, {1, 3}, {3, 3}};
+
+    for(auto const &i : walls)
+    {
+        grid.SetWall(i[0], i[1], true);
+    }
+
+    placementMap.Build(grid, 0, 0, 4, 3);
+
+    SECTION("Test cubes that would block the path")
+    {
+        REQUIRE(placementMap.IsBlocking(grid, 0, 0) == true);
+        REQUIRE(placementMap.IsBlocking(grid, 4, 3) == true);
+        REQUIRE(placementMap.IsBlocking(grid, 4, 2) == true);
+    }
+
+    SECTION("Test cubes that would not block the path")
+    {
+        REQUIRE(placementMap.IsBlocking(grid, 1, 0) == false);
+        REQUIRE(placementMap.IsBlocking(grid, 4, 0) == false);
+        REQUIRE(placementMap.IsBlocking(grid, 4, 1) == false);
+        REQUIRE(placementMap.IsBlocking(grid, 0, 2) == false);
+        REQUIRE(placementMap.IsBlocking(grid, 2, 3) == false);
+        REQUIRE(placementMap.IsBlocking(grid, 1, 1) == false);
+        REQUIRE(placementMap.IsBlocking(grid, -5, -5) == false);
+    }
+
+    SECTION("Test IsUpToDate")
+    {
+        REQUIRE(placementMap.IsUpToDate(grid, 0, 0, 4, 3) == true);
+        REQUIRE(placementMap.IsUpToDate(grid, 0, 0, 4, 2) == false);
+
+        grid.SetWall(1, 0, true);
+        REQUIRE(placementMap.IsUpToDate(grid, 0, 0, 4, 3) == false);
+
+        /* The path goes through the left side now. */
+        placementMap.Build(grid, 0, 0, 4, 3);
+        REQUIRE(placementMap.IsBlocking(grid, 0, 1) == true);
+        REQUIRE(placementMap.IsBlocking(grid, 2, 3) == false);
+    }
+
+    SECTION("Test with no path")
+    {
+        grid.SetWall(4, 2, true);
+        placementMap.Build(grid, 0, 0, 4, 3);
+        REQUIRE(placementMap.IsBlocking(grid, 1, 0) == true);
+        REQUIRE(placementMap.IsBlocking(grid, 4, 2) == false);
+    }
+}
+
+TEST_CASE("Tests for PlacementMap against FindPath", "[PlacementMap]")
+{
+    Path path;
+
+    srand(11);
+
+    for(int test = 0; test < 20; test++)
+    {
+        Grid grid;
+        PlacementMap placementMap;
+
+        /* Setting up a 12x12 grid with random walls. */
+        for(int x = 0; x < 12; x++)
+        {
+            for(int y = 0; y < 12; y++)
+            {
+                grid.AddCube(x, y, 0, 0);
+                grid.SetWall(x, y, rand() % 100 < 30);
+            }
+        }
+
+        grid.SetWall(0, 0, false);
+        grid.SetWall(11, 11, false);
+        placementMap.Build(grid, 0, 0, 11, 11);
+
+        /* Place a wall on every walkable cube and search for a path. */
+        for(int x = 0; x < 12; x++)
+        {
+            for(int y = 0; y < 12; y++)
+            {
+                if(grid.At(x, y)->IsWall())
+                {
+                    continue;
+                }
+
+                bool isBlocking = placementMap.IsBlocking(grid, x, y);
+
+                grid.SetWall(x, y, true);
+                REQUIRE(isBlocking == !path.FindPath(0, 0, 11, 11, grid));
+                grid.SetWall(x, y, false);
+            }
+        }
+    }
+}
+
+TEST_CASE("Tests for PlacementMap with several destinations",
+          "[PlacementMap]")
+{
+    Path path;
+    std::vector<Coordinates> destinations = {{11, 11}, {11, 0}, {0, 11}};
+
+    srand(12);
+
+    for(int test = 0; test < 20; test++)
+    {
+        Grid grid;
+        PlacementMap placementMap;
+
+        /* Setting up a 12x12 grid with random walls. */
+        for(int x = 0; x < 12; x++)
+        {
+            for(int y = 0; y < 12; y++)
+            {
+                grid.AddCube(x, y, 0, 0);
+                grid.SetWall(x, y, rand() % 100 < 35);
+            }
+        }
+
+        grid.SetWall(0, 0, false);
+
+        for(auto const &i : destinations)
+        {
+            grid.SetWall(i.x, i.y, false);
+        }
+
+        placementMap.Build(grid, 0, 0, destinations);
+
+        REQUIRE(placementMap.IsUpToDate(grid, 0, 0, destinations) == true);
+        REQUIRE(placementMap.IsUpToDate(grid, 0, 0, 11, 11) == false);
+
+        /* A wall blocks the path if no destination can be reached. */
+        for(int x = 0; x < 12; x++)
+        {
+            for(int y = 0; y < 12; y++)
+            {
+                if(grid.At(x, y)->IsWall())
+                {
+                    continue;
+                }
+
+                bool isBlocking = placementMap.IsBlocking(grid, x, y);
+                bool isReachable = false;
+
+                grid.SetWall(x, y, true);
+
+                for(auto const &i : destinations)
+                {
+                    isReachable = isReachable
+                                  || path.FindPath(0, 0, i.x, i.y, grid);
+                }
+
+                REQUIRE(isBlocking == !isReachable);
+                grid.SetWall(x, y, false);
+            }
+        }
+    }
+}
+
+TEST_CASE("Tests for Level::IsPlacementBlocking", "[PlacementMap]")
+{
+    Level level;
+
+    /*
+     * o represents walkable areas.
+     * x represents walls.
+     * S are the spawn points, D the destinations.
+     *
+     * Grid setup:
+     * Sooxo
+     * oxoxS
+     * Doooo
+     * xxxxD
+     */
+    for(int y = 0; y < 4; y++)
+    {
+        for(int x = 0; x < 5; x++)
+        {
+            level.grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    int walls[6][2] = {{1, 1}, {3, 0}, {3, 1}, {0, 3}, {1, 3}, {2, 3}};
+
+    for(auto const &i : walls)
+    {
+        level.grid.SetWall(i[0], i[1], true);
+    }
+
+    level.grid.SetWall(3, 3, true);
+    level.spawnPoints = {{0, 0}, {4, 1}, {0, 0}};
+    level.destinations = {{0, 2}, {4, 3}};
+
+    SECTION("Test cubes cutting the second spawn point only")
+    {
+        /* (4, 2) is the only way out of the second spawn point. */
+        REQUIRE(level.IsPlacementBlocking(4, 2) == true);
+        REQUIRE(level.IsPlacementBlocking(4, 1) == true);
+    }
+
+    SECTION("Test cubes cutting one destination only")
+    {
+        /* The first spawn point still reaches (0, 2) through (0, 1). */
+        REQUIRE(level.IsPlacementBlocking(1, 0) == false);
+        REQUIRE(level.IsPlacementBlocking(2, 1) == false);
+        REQUIRE(level.IsPlacementBlocking(4, 3) == false);
+    }
+
+    SECTION("Test cubes cutting every destination")
+    {
+        level.grid.SetWall(0, 1, true);
+
+        REQUIRE(level.IsPlacementBlocking(1, 0) == true);
+        REQUIRE(level.IsPlacementBlocking(0, 0) == true);
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Tested class: Reachability
+ *
+ * This file unit tests the scenarios for the methods in the Reachability
+ * class, comparing its answers with the ones of the pathfinder.
+ */
+
+#include <cstdlib>
+#include "../~External Libraries/catch.hpp"
+#include "../Level/Reachability.h"
+#include "../Level/Path.h"
+
+TEST_CASE("Tests for Reachability", "[Reachability]")
+{
+    Grid grid;
+    Reachability reachability;
+
+    /*
+     * Same pattern as the pathfinder tests.
+     * o represents walkable areas.
+     * x represents walls.
+     * Spaces represent empty grid cells.
+     *
+     * Grid setup:
+     * o oo
+     * oxox
+     * oooo
+     */
+    for(int x = 0; x < 3; x++)
+    {
+        for(int y = 0; y < 4; y++)
+        {
+            if(x != 0 || y != 2)
+            {
+                grid.AddCube(x, y, 0, 0);
+            }
+        }
+    }
+
+    grid.SetWall(1, 0, true);
+    grid.SetWall(1, 2, true);
+
+    SECTION("Test with invalid starting and ending points")
+    {
+        REQUIRE(reachability.IsReachable(grid, 0, 0, 0, 0) == false);
+        REQUIRE(reachability.IsReachable(grid, -5, -5, 0, 3) == false);
+        REQUIRE(reachability.IsReachable(grid, 0, 0, -5, -5) == false);
+        REQUIRE(reachability.IsReachable(grid, 0, 2, 0, 3) == false);
+        REQUIRE(reachability.IsReachable(grid, 1, 0, 0, 3) == false);
+        REQUIRE(reachability.IsReachable(grid, 0, 3, 1, 0) == false);
+    }
+
+    SECTION("Test with path navigating through obstacles")
+    {
+        REQUIRE(reachability.IsReachable(grid, 0, 0, 0, 3) == true);
+        REQUIRE(reachability.IsReachable(grid, 2, 3, 0, 3) == true);
+    }
+
+    SECTION("Test with walls changing between checks")
+    {
+        REQUIRE(reachability.IsReachable(grid, 0, 0, 0, 3) == true);
+
+        grid.SetWall(0, 1, true);
+        REQUIRE(reachability.IsReachable(grid, 0, 0, 0, 3) == false);
+        REQUIRE(reachability.IsReachable(grid, 2, 0, 0, 3) == true);
+
+        grid.SetWall(0, 1, false);
+        REQUIRE(reachability.IsReachable(grid, 0, 0, 0, 3) == true);
+    }
+}
+
+TEST_CASE("Tests for Reachability against FindPath", "[Reachability]")
+{
+    Grid grid;
+    Path path;
+    Reachability reachability;
+
+    /*
+     * Setting up a grid wider than a 64-bit word (rows use five words) with
+     * random walls.
+     */
+    srand(7);
+
+    for(int x = 0; x < 300; x++)
+    {
+        for(int y = 0; y < 20; y++)
+        {
+            grid.AddCube(x, y, 0, 0);
+            grid.SetWall(x, y, rand() % 100 < 35);
+        }
+    }
+
+    for(int i = 0; i < 300; i++)
+    {
+        int startX = rand() % 300;
+        int startY = rand() % 20;
+        int endX = rand() % 300;
+        int endY = rand() % 20;
+
+        /* Change a few walls, so that the bitsets are updated too. */
+        if(i % 10 == 0)
+        {
+            grid.SetWall(rand() % 300, rand() % 20, rand() % 2 == 0);
+        }
+
+        REQUIRE(reachability.IsReachable(grid, startX, startY, endX, endY)
+                == path.FindPath(startX, startY, endX, endY, grid));
+    }
+}
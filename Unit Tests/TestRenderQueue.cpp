@@ -0,0 +1,96 @@
+/*
+ * Tested class: RenderQueue
+ *
+ * This file unit tests the scenarios for the methods in the RenderQueue
+ * class.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include "../~External Libraries/catch.hpp"
+#include "../Display/RenderQueue.h"
+
+TEST_CASE("Tests for RenderQueue", "[RenderQueue]")
+{
+    RenderQueue renderQueue;
+
+    SECTION("Test the drawing order of the fields")
+    {
+        renderQueue.Push(RENDER_LAYER_HIGHLIGHT, 0, 0, 0,
+                         RENDER_ITEM_HIGHLIGHT, 0);
+        renderQueue.Push(RENDER_LAYER_LEVEL, 2, 0, 0, RENDER_ITEM_CUBE, 1);
+        renderQueue.Push(RENDER_LAYER_LEVEL, 1, 30, 5, RENDER_ITEM_UNIT, 2);
+        renderQueue.Push(RENDER_LAYER_LEVEL, 1, 10, 9, RENDER_ITEM_TOWER, 3);
+        renderQueue.Push(RENDER_LAYER_LEVEL, 1, 0, 0, RENDER_ITEM_CUBE, 4);
+        renderQueue.Push(RENDER_LAYER_LEVEL, 1, 0, 1, RENDER_ITEM_CUBE, 5);
+        renderQueue.Sort();
+
+        const std::vector<RenderItem> &items = renderQueue.GetItems();
+        std::vector<int> indexes;
+
+        for(auto const &i : items)
+        {
+            indexes.push_back(i.index);
+        }
+
+        REQUIRE(indexes == std::vector<int>({4, 5, 3, 2, 1, 0}));
+        REQUIRE(items[2].type == RENDER_ITEM_TOWER);
+    }
+
+    SECTION("Test that equal keys keep their order")
+    {
+        for(int i = 0; i < 10; i++)
+        {
+            renderQueue.Push(RENDER_LAYER_LEVEL, 3, 0, 0, RENDER_ITEM_CUBE, i);
+            renderQueue.Push(RENDER_LAYER_LEVEL, 2, 0, 0, RENDER_ITEM_CUBE,
+                             10 + i);
+        }
+
+        renderQueue.Sort();
+
+        for(int i = 0; i < 20; i++)
+        {
+            REQUIRE(renderQueue.GetItems()[i].index == (i + 10) % 20);
+        }
+    }
+
+    SECTION("Test against a comparison sort")
+    {
+        srand(3);
+
+        for(int i = 0; i < 5000; i++)
+        {
+            renderQueue.Push(rand() % 2, rand() % 3000, rand() % 70000,
+                             rand() % 600, RENDER_ITEM_CUBE, i);
+        }
+
+        std::vector<RenderItem> items = renderQueue.GetItems();
+
+        std::stable_sort(items.begin(), items.end(),
+                         [](const RenderItem &a, const RenderItem &b)
+                         {
+                             return a.key < b.key;
+                         });
+        renderQueue.Sort();
+
+        bool isSameOrder = true;
+
+        for(unsigned int i = 0; i < items.size(); i++)
+        {
+            if(renderQueue.GetItems()[i].index != items[i].index)
+            {
+                isSameOrder = false;
+            }
+        }
+
+        REQUIRE(isSameOrder);
+    }
+
+    SECTION("Test clearing the queue")
+    {
+        renderQueue.Push(RENDER_LAYER_LEVEL, 0, 0, 0, RENDER_ITEM_CUBE, 0);
+        renderQueue.Clear();
+        renderQueue.Sort();
+        REQUIRE(renderQueue.GetItems().empty());
+    }
+}
@@ -0,0 +1,234 @@
+/*
+ * Tested class: RouteIndex
+ *
+ * This file unit tests the scenarios for the methods in the RouteIndex class
+ * and the selective replanning of the units of a level.
+ */
+
+#include <algorithm>
+#include "../~External Libraries/catch.hpp"
+#include "../Level/Level.h"
+
+TEST_CASE("Tests for RouteIndex", "[RouteIndex]")
+{
+    Grid grid;
+    RouteIndex routeIndex;
+    Path path;
+    std::vector<int> units;
+
+    /* Open 5 x 5 grid. */
+    for(int x = 0; x < 5; x++)
+    {
+        for(int y = 0; y < 5; y++)
+        {
+            grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    /* (0, 0) -> (2, 0) -> (2, 1). */
+    path.SetDirections({DIRECTION_RIGHT, DIRECTION_RIGHT, DIRECTION_DOWN});
+
+    SECTION("Test that every cube of a route is indexed")
+    {
+        routeIndex.SetRoute(0, 0, 0, path.GetDirections(), grid);
+
+        REQUIRE(routeIndex.GetNbUnits() == 1);
+
+        routeIndex.GetUnits(0, 0, grid, units);
+        REQUIRE(units == std::vector<int>{0});
+        routeIndex.GetUnits(2, 0, grid, units);
+        REQUIRE(units == std::vector<int>{0});
+        routeIndex.GetUnits(2, 1, grid, units);
+        REQUIRE(units == std::vector<int>{0});
+        routeIndex.GetUnits(0, 1, grid, units);
+        REQUIRE(units.empty());
+        routeIndex.GetUnits(-5, -5, grid, units);
+        REQUIRE(units.empty());
+    }
+
+    SECTION("Test that replacing and removing routes updates the cubes")
+    {
+        routeIndex.SetRoute(0, 0, 0, path.GetDirections(), grid);
+        routeIndex.SetRoute(3, 1, 0, path.GetDirections(), grid);
+
+        routeIndex.GetUnits(2, 0, grid, units);
+        std::sort(units.begin(), units.end());
+        REQUIRE(units == std::vector<int>({0, 3}));
+
+        /* The unit 0 now goes down from (0, 0). */
+        path.SetDirections({DIRECTION_DOWN});
+        routeIndex.SetRoute(0, 0, 0, path.GetDirections(), grid);
+
+        routeIndex.GetUnits(2, 0, grid, units);
+        REQUIRE(units == std::vector<int>{3});
+        routeIndex.GetUnits(0, 1, grid, units);
+        REQUIRE(units == std::vector<int>{0});
+
+        routeIndex.RemoveRoute(3);
+        routeIndex.GetUnits(2, 0, grid, units);
+        REQUIRE(units.empty());
+    }
+}
+
+TEST_CASE("Tests for ReplanAffectedUnits", "[RouteIndex]")
+{
+    Level level;
+
+    /* Open 5 x 5 grid with the destination in a corner. */
+    for(int x = 0; x < 5; x++)
+    {
+        for(int y = 0; y < 5; y++)
+        {
+            level.grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    level.destination = {4, 4};
+
+    for(int i = 0; i < 2; i++)
+    {
+        level.units.push_back(Unit(0, 10, 1, 1, 0));
+    }
+
+    level.units[0].cubeX = 0;
+    level.units[0].cubeY = 4;
+    level.units[1].cubeX = 4;
+    level.units[1].cubeY = 0;
+
+    level.FindUnitPaths();
+
+    Path firstRoute = level.units[0].path;
+    Path secondRoute = level.units[1].path;
+
+    REQUIRE(firstRoute.GetDirections().size() == 4);
+    REQUIRE(secondRoute.GetDirections().size() == 4);
+
+    SECTION("Test that only the units crossing the tower are replanned")
+    {
+        /* (2, 4) is only on the route of the first unit. */
+        level.grid.SetWall(2, 4, true);
+
+        REQUIRE(level.ReplanAffectedUnits(2, 4) == 1);
+        REQUIRE(level.units[0].path.GetDirections().size() == 6);
+        REQUIRE(level.units[1].path.GetPackedPath()
+                == secondRoute.GetPackedPath());
+
+        /* The new route is indexed, the old one is not anymore. */
+        std::vector<int> units;
+        level.routeIndex.GetUnits(2, 4, level.grid, units);
+        REQUIRE(units.empty());
+        level.routeIndex.GetUnits(0, 4, level.grid, units);
+        REQUIRE(units == std::vector<int>{0});
+    }
+
+    SECTION("Test that selling a tower only replans units without route")
+    {
+        /* Surrounds the second unit: (3, 0) and (4, 1). */
+        level.grid.SetWall(3, 0, true);
+        level.grid.SetWall(4, 1, true);
+        level.ReplanAffectedUnits(3, 0);
+        level.ReplanAffectedUnits(4, 1);
+
+        REQUIRE(level.units[1].path.GetDirections().empty());
+
+        level.grid.SetWall(4, 1, false);
+
+        REQUIRE(level.ReplanAffectedUnits(4, 1) == 1);
+        REQUIRE(level.units[1].path.GetDirections().size() == 4);
+        REQUIRE(level.units[0].path.GetPackedPath()
+                == firstRoute.GetPackedPath());
+    }
+
+    SECTION("Test that selling a tower replans the units with a detour")
+    {
+        level.grid.SetWall(2, 4, true);
+        level.ReplanAffectedUnits(2, 4);
+
+        REQUIRE(level.units[0].path.GetDirections().size() == 6);
+
+        level.grid.SetWall(2, 4, false);
+
+        REQUIRE(level.ReplanAffectedUnits(2, 4) == 1);
+        REQUIRE(level.units[0].path.GetDirections().size() == 4);
+        REQUIRE(level.units[1].path.GetPackedPath()
+                == secondRoute.GetPackedPath());
+    }
+
+    SECTION("Test that the index follows the units moved in the vector")
+    {
+        /* Same number of units, but not in the same order. */
+        std::swap(level.units[0], level.units[1]);
+        level.grid.SetWall(2, 4, true);
+
+        REQUIRE(level.ReplanAffectedUnits(2, 4) == 1);
+        REQUIRE(level.units[1].path.GetDirections().size() == 6);
+        REQUIRE(level.units[0].path.GetPackedPath()
+                == secondRoute.GetPackedPath());
+    }
+
+    SECTION("Test a cube crossed by no route")
+    {
+        level.grid.SetWall(0, 0, true);
+
+        REQUIRE(level.ReplanAffectedUnits(0, 0) == 0);
+        REQUIRE(level.ReplanAffectedUnits(-5, -5) == 0);
+    }
+}
+
+TEST_CASE("Tests for ReplanAffectedUnits with a walking unit", "[RouteIndex]")
+{
+    Level level;
+
+    /* Open 5 x 5 grid. */
+    for(int x = 0; x < 5; x++)
+    {
+        for(int y = 0; y < 5; y++)
+        {
+            level.grid.AddCube(x, y, 0, 0);
+        }
+    }
+
+    /* (2, 0) -> (3, 0) -> (3, 4), the shortest route. */
+    level.destination = {3, 4};
+    level.units.push_back(Unit(0, 10, 1, 1, 0));
+    level.units[0].cubeX = 2;
+    level.units[0].cubeY = 0;
+    level.units[0].path.SetDirections({DIRECTION_RIGHT, DIRECTION_DOWN,
+                                       DIRECTION_DOWN, DIRECTION_DOWN,
+                                       DIRECTION_DOWN});
+
+    /* Walk until the unit enters (3, 0), before the middle of the cube. */
+    while(level.units[0].cubeX == 2)
+    {
+        level.units[0].WalkWithPath(8);
+    }
+
+    REQUIRE(level.units[0].path.GetDirections().size() == 5);
+    REQUIRE(level.units[0].GetRouteFromCube().size() == 4);
+
+    level.routeIndex.Build(level.units, level.grid);
+
+    SECTION("Test that the route is indexed from the cube of the unit")
+    {
+        std::vector<int> units;
+
+        level.routeIndex.GetUnits(3, 2, level.grid, units);
+        REQUIRE(units == std::vector<int>{0});
+        level.routeIndex.GetUnits(4, 1, level.grid, units);
+        REQUIRE(units.empty());
+
+        level.grid.SetWall(3, 2, true);
+
+        REQUIRE(level.ReplanAffectedUnits(3, 2) == 1);
+        REQUIRE(level.units[0].GetRouteFromCube().size() == 6);
+    }
+
+    SECTION("Test that selling a tower keeps the shortest route")
+    {
+        level.grid.SetWall(0, 4, true);
+        level.grid.SetWall(0, 4, false);
+
+        REQUIRE(level.ReplanAffectedUnits(0, 4) == 0);
+        REQUIRE(level.units[0].path.GetDirections().size() == 5);
+    }
+}
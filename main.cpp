@@ -28,9 +28,11 @@
 #include "Controllers/GameEvents.h"
 #include "Controllers/MenuEvents.h"
 #include "Controllers/LevelSelectEvents.h"
+#include "Level/PathStats.h"
 
 /* Catch library configuration used for unit testing. */
 #define CATCH_CONFIG_RUNNER
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "~External Libraries/catch.hpp"
 
 int main(int argc, char * argv[])
@@ -116,8 +118,12 @@ int main(int argc, char * argv[])
         }
 
         renderer.RenderSceneHud(display, scene, scene.textures);
+        renderer.EndFrame(display.renderer);
 
         SDL_RenderPresent(display.renderer);
+
+        /* The searches of the next frame are counted separately. */
+        PathFrameStats::EndFrame();
     }
 
     return result;